@@ -0,0 +1,359 @@
+// Client-server API(PICO)        //
+// Chat benchmark                 //
+// Version 0.9.1pi                //
+// Bachelor's Work Project        //
+// Technical University of Kosice //
+// 17.10.2026                     //
+// Nikita Kuropatkin              //
+// Host tools for                 //
+// W5100S-EVB-Pico                //
+
+/*
+End-to-end benchmark of the host build of the client.
+The reference server runs in a thread, the unchanged client binary is
+started as a child process and driven through stdin with a scripted
+session (menus, PIN, messages, stop-word). All sessions run in one client
+process, menus are answered only in the first one.
+Reported values:
+- handshakes/sec (server side, accept -> client`s MAC verified),
+- messages/sec and p50/p99 latency of one message round trip
+  (line written to client`s stdin -> echo printed by client),
+- bytes of chat frames on the wire against the same frames without
+  padding of messages(MESSAGE_PADDING), for the sent messages and for
+  every size of compressed text up to BUFF_MAX.
+With -d the full-duplex client(client_pico_duplex) is used and all
+messages of a session are written at once(pipelined), so only 
+messages/sec is reported.
+Usage: bench_chat [-d] [-s sessions] [-m messages] [-l length] [-p port] [-c client]
+*/
+#include <errno.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include "server.h"
+#include "random.h"
+#include "crypto.h"
+#include "parameters.h"
+
+#ifndef CLIENT_PICO_BIN
+  #define CLIENT_PICO_BIN "./client_pico"
+#endif
+#ifndef CLIENT_PICO_DUPLEX_BIN
+  #define CLIENT_PICO_DUPLEX_BIN "./client_pico_duplex"
+#endif
+
+/*Settings of the benchmark*/
+static int sessions = 6;
+static int messages = 50;
+static int length = 64;
+static int port = PORT;
+static int duplex = NO;
+
+/*Shared with the server thread*/
+static int listen_fd;
+static uint8_t plain_key[KEYSZ];
+static uint64_t *handshake_us;
+
+/*Client process*/
+static pid_t client_pid = -1;
+static int client_in = -1;
+static int client_out = -1;
+static char out_buf[8192];
+static size_t out_len = 0;
+
+/*
+Server thread: one accepted connection per session.
+*/
+static void *server_thread(void *arg)
+{
+ (void)arg;
+ for (int i = 0; i < sessions; i++) {
+    uint8_t writing_key[KEYSZ];
+    uint8_t reading_key[KEYSZ];
+    int fd = server_accept(listen_fd);
+    if (fd < 0) {
+       i--;
+       continue;
+    }
+    uint64_t start = server_now_us();
+    server_handshake(fd, plain_key, writing_key, reading_key);
+    handshake_us[i] = server_now_us() - start;
+    server_chat(fd, writing_key, reading_key);
+    close(fd);
+ }
+ return NULL;
+}
+
+/*
+Starts the client with stdin/stdout connected to pipes.
+*/
+static void client_start(const char *client_bin, const char *flash_path)
+{
+ int in_pipe[2];
+ int out_pipe[2];
+ if (pipe(in_pipe) != 0 || pipe(out_pipe) != 0) {
+    perror("pipe");
+    exit(EXIT_FAILURE);
+ }
+ client_pid = fork();
+ if (client_pid < 0) {
+    perror("fork");
+    exit(EXIT_FAILURE);
+ }
+ if (client_pid == 0) {
+    dup2(in_pipe[0], STDIN_FILENO);
+    dup2(out_pipe[1], STDOUT_FILENO);
+    close(in_pipe[0]);
+    close(in_pipe[1]);
+    close(out_pipe[0]);
+    close(out_pipe[1]);
+    close(listen_fd);
+    setenv("CLIENT_PICO_FLASH", flash_path, 1);
+    execl(client_bin, client_bin, (char *)NULL);
+    perror("exec");
+    _exit(EXIT_FAILURE);
+ }
+ close(in_pipe[0]);
+ close(out_pipe[1]);
+ client_in = in_pipe[1];
+ client_out = out_pipe[0];
+ out_len = 0;
+}
+
+/*
+Stops the client, it runs sessions forever, so it is killed.
+*/
+static void client_stop(void)
+{
+ kill(client_pid, SIGTERM);
+ close(client_in);
+ waitpid(client_pid, NULL, 0);
+ close(client_out);
+ client_pid = -1;
+}
+
+/*
+Writes `text` to the client`s stdin.
+*/
+static void client_write(const char *text)
+{
+ size_t len = strlen(text);
+ while (len > 0) {
+    ssize_t retval = write(client_in, text, len);
+    if (retval < 0 && errno == EINTR) continue;
+    if (retval <= 0) {
+       fprintf(stderr, "Client closed stdin\n");
+       exit(EXIT_FAILURE);
+    }
+    text += retval;
+    len -= (size_t)retval;
+ }
+}
+
+/*
+Reads the client`s stdout until `marker` is printed, output up to
+the end of the marker is consumed.
+*/
+static void client_wait_for(const char *marker)
+{
+ const size_t marker_len = strlen(marker);
+ while (1) {
+    out_buf[out_len] = '\0';
+    char *hit = strstr(out_buf, marker);
+    if (hit != NULL) {
+       size_t used = (size_t)(hit - out_buf) + marker_len;
+       memmove(out_buf, out_buf + used, out_len - used);
+       out_len -= used;
+       return;
+    }
+    if (strstr(out_buf, "!Error occurred!") != NULL) {
+       fprintf(stderr, "Client failed:%s\n", strstr(out_buf, "!Error occurred!") + 16);
+       exit(EXIT_FAILURE);
+    }
+    /*Keep only the tail that can still contain the marker*/
+    if (out_len > sizeof(out_buf) / 2) {
+       memmove(out_buf, out_buf + out_len - marker_len, marker_len);
+       out_len = marker_len;
+    }
+    ssize_t retval = read(client_out, out_buf + out_len, sizeof(out_buf) - 1 - out_len);
+    if (retval < 0 && errno == EINTR) continue;
+    if (retval <= 0) {
+       fprintf(stderr, "Client ended before printing \"%s\"\n", marker);
+       exit(EXIT_FAILURE);
+    }
+    out_len += (size_t)retval;
+ }
+}
+
+static int compare_u64(const void *a, const void *b)
+{
+ uint64_t x = *(const uint64_t *)a;
+ uint64_t y = *(const uint64_t *)b;
+ return (x > y) - (x < y);
+}
+
+/*
+Bandwidth overhead of pad_message() for every size of compressed text
+from 1 to BUFF_MAX(all sizes equally likely), frames include the padded
+MAC and size like on the wire.
+*/
+static void padding_overhead(void)
+{
+ uint8_t message[MESSAGE_MAX];
+ const uint64_t header = PADME_SIZE(MACSZ) + BYTE_ARRAY_SZ;
+ uint64_t wire = 0, unpadded = 0;
+ double worst = 0.0;
+ uint32_t worst_size = 0;
+ for (uint32_t size = 1; size <= BUFF_MAX; size++) {
+    uint64_t padded_frame = header + pad_message(message, size);
+    uint64_t frame = header + size;
+    double overhead = (double)(padded_frame - frame) / (double)frame;
+    if (overhead > worst) {
+       worst = overhead;
+       worst_size = size;
+    }
+    wire += padded_frame;
+    unpadded += frame;
+ }
+ printf("padding over sizes 1..%d B: overhead mean %.1f %%, worst %.1f %% (%lu B)\n",
+        BUFF_MAX, 100.0 * (double)(wire - unpadded) / (double)unpadded,
+        100.0 * worst, (unsigned long)worst_size);
+}
+
+int main(int argc, char **argv)
+{
+ const char *client_bin = NULL;
+ int opt;
+ while ((opt = getopt(argc, argv, "ds:m:l:p:c:")) != -1) {
+    switch (opt) {
+       case 'd': duplex = YES; break;
+       case 's': sessions = atoi(optarg); break;
+       case 'm': messages = atoi(optarg); break;
+       case 'l': length = atoi(optarg); break;
+       case 'p': port = atoi(optarg); break;
+       case 'c': client_bin = optarg; break;
+       default:
+          fprintf(stderr, "Usage: %s [-d] [-s sessions] [-m messages] [-l length] [-p port] [-c client]\n", argv[0]);
+          return EXIT_FAILURE;
+    }
+ }
+ if (client_bin == NULL) {
+    client_bin = (duplex == YES) ? CLIENT_PICO_DUPLEX_BIN : CLIENT_PICO_BIN;
+ }
+ /*Port buffer of the client holds 4 digits, message must fit TEXT_MAX*/
+ if (sessions < 1 || messages < 1 || length < 1 || length > TEXT_MAX - 2 ||
+     port <= PORT_START || port > 9999) {
+    fprintf(stderr, "Invalid arguments\n");
+    return EXIT_FAILURE;
+ }
+ signal(SIGPIPE, SIG_IGN);
+
+ char flash_path[64];
+ snprintf(flash_path, sizeof(flash_path), "/tmp/bench_chat_flash_%d.bin", (int)getpid());
+
+ random_init();
+ server_provision(flash_path, plain_key);
+ listen_fd = server_listen(port);
+
+ handshake_us = calloc((size_t)sessions, sizeof(uint64_t));
+ uint64_t *latency_us = calloc((size_t)sessions * messages, sizeof(uint64_t));
+ if (handshake_us == NULL || latency_us == NULL) {
+    fprintf(stderr, "Memory allocation failed\n");
+    return EXIT_FAILURE;
+ }
+
+ pthread_t thread;
+ pthread_create(&thread, NULL, server_thread, NULL);
+
+ /*Message text, must not start with the stop-word*/
+ static const char text[] = "status ok; sensor 42 reading nominal ";
+ char line[TEXT_MAX];
+ for (int i = 0; i < length; i++) line[i] = text[i % (sizeof(text) - 1)];
+ line[length] = '\n';
+ line[length + 1] = '\0';
+
+ /*First session goes through menus, next ones start with the PIN*/
+ char header[128];
+ char pin_line[32];
+ snprintf(header, sizeof(header), "start\n2\n2\n127.0.0.1\n%d\n%s\n", port, SERVER_PIN);
+ snprintf(pin_line, sizeof(pin_line), "%s\n", SERVER_PIN);
+
+ uint64_t chat_us = 0;
+ int done = 0;
+ for (int s = 0; s < sessions; s++) {
+    if (client_pid < 0) {
+       client_start(client_bin, flash_path);
+       client_write(header); // Menus and PIN
+    }
+    else client_write(pin_line);
+    client_wait_for("To server: "); // Handshake and nonces are done
+
+    uint64_t chat_start = server_now_us();
+    if (duplex == YES) {
+       /*All messages at once, the client sends them without waiting*/
+       for (int m = 0; m < messages; m++) client_write(line);
+       for (int m = 0; m < messages; m++) {
+          client_wait_for("From server: ");
+          client_wait_for("\n");
+          done++;
+       }
+    }
+    else {
+       for (int m = 0; m < messages; m++) {
+          uint64_t start = server_now_us();
+          client_write(line);
+          client_wait_for("From server: ");
+          client_wait_for("\n");
+          latency_us[done++] = server_now_us() - start;
+       }
+    }
+    chat_us += server_now_us() - chat_start;
+
+    client_write("exit\n");
+    client_wait_for("Session ended, press Enter");
+    if (s + 1 < sessions) client_write("\n");
+ }
+ client_stop();
+ pthread_join(thread, NULL);
+ close(listen_fd);
+ unlink(flash_path);
+
+ uint64_t handshake_total = 0;
+ for (int i = 0; i < sessions; i++) handshake_total += handshake_us[i];
+ qsort(latency_us, (size_t)done, sizeof(uint64_t), compare_u64);
+ size_t p99 = (size_t)done * 99 / 100;
+ if (p99 >= (size_t)done) p99 = (size_t)done - 1;
+
+ printf("parameters: TEXT_MAX=%d BUFF_MAX=%d BLOCK_AMOUNT=%d ITERATIONS=%d message=%d B\n",
+        TEXT_MAX, BUFF_MAX, BLOCK_AMOUNT, ITERATIONS, length);
+ printf("sessions: %d, handshake mean: %.3f ms, handshakes/sec: %.2f\n",
+        sessions, handshake_total / 1000.0 / sessions,
+        sessions * 1e6 / (double)handshake_total);
+ printf("messages: %d, messages/sec: %.1f\n", done, done * 1e6 / (double)chat_us);
+ if (duplex == YES) {
+    printf("latency: not measured(pipelined full-duplex session)\n");
+ }
+ else {
+    printf("latency p50: %llu us, p99: %llu us\n",
+           (unsigned long long)latency_us[done / 2],
+           (unsigned long long)latency_us[p99]);
+ }
+
+ struct server_traffic traffic;
+ server_traffic_get(&traffic);
+ printf("padding(MESSAGE_PADDING=%s): %llu frames, %.1f B/frame on the wire, unpadded %.1f B/frame, overhead %.1f %%\n",
+        (MESSAGE_PADDING == YES) ? "YES" : "NO", (unsigned long long)traffic.frames,
+        (double)traffic.wire / (double)traffic.frames,
+        (double)traffic.unpadded / (double)traffic.frames,
+        100.0 * (double)(traffic.wire - traffic.unpadded) / (double)traffic.unpadded);
+ padding_overhead();
+
+ free(handshake_us);
+ free(latency_us);
+ return EXIT_SUCCESS;
+}
@@ -0,0 +1,356 @@
+// Client-server API(PICO)        //
+// Compression benchmark          //
+// Version 0.9.1pi                //
+// Bachelor's Work Project        //
+// Technical University of Kosice //
+// 17.10.2026                     //
+// Nikita Kuropatkin              //
+// Host tools for                 //
+// W5100S-EVB-Pico                //
+
+/*
+Benchmark of compress_text()/decompress_text() on a corpus of chat
+lines(one message per line, sent with '\n' like fgets() gives it).
+Every message is compressed and decompressed, the result is checked
+against the original. First LZRW3-A16 is checked against LZRW3-A: 
+same output with 4096 entries and each decompresses the other. For 
+every backend(LZRW3-A, LZRW3-A16, LZSS) is reported:
+- work memory of one context on this host and with 32-bit pointers
+  (RP2040), it is all RAM the backend takes besides its stack,
+- cycles per message of compress_text() and decompress_text(),
+- bytes of the compressed texts and on the wire(padded MAC, size and 
+  padded message of chat()), for every message compressed alone and 
+  with the history of the session(stream mode, whatever COMPRESS_STREAM is),
+- messages sent stored(COMPRESS_STORED header, no backend on any side).
+The table is without the dictionary(COMPRESS_DICT). LZRW3-A is then run
+with the dictionary of compress_dict.c(built from the whole corpus, so 
+it has seen every message) and with one trained here on the even lines 
+and measured on the odd ones(messages it has not seen), the wire bytes
+saved against no dictionary are reported.
+For the backend of COMPRESS_BACKEND also cycles with the work memory
+allocated for every call(as before the compression context) against
+one context per session(ALLOCATION in parameters.h).
+Usage: bench_compress [corpus file]
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bench_cycles.h"
+#include "dict_train.h"
+#include "lzrw.h"
+#include "lzrw3a16.h"
+#include "compress_decompress.h"
+#include "compress_dict.h"
+#include "crypto.h"
+#include "error.h"
+#include "parameters.h"
+
+#ifndef CHAT_CORPUS
+  #define CHAT_CORPUS "chat_corpus.txt"
+#endif
+
+/*
+In use: here.
+Rounds over the whole corpus per measurement, the best of BENCH_REPEAT
+measurements is reported(host timing is noisy).
+*/
+#define BENCH_ROUNDS 50
+#define BENCH_REPEAT 5
+
+/*Corpus: messages with terminating '\n' and '\0', as sent by the client*/
+#define CORPUS_MAX 4096
+static char corpus[CORPUS_MAX][TEXT_MAX];
+static int corpus_size = 0;
+
+/*
+Reads one message per line of `path`, too long lines are cut to TEXT_MAX.
+*/
+static void corpus_load(const char *path)
+{
+ FILE *file = fopen(path, "r");
+ if (file == NULL) {
+    perror(path);
+    exit(EXIT_FAILURE);
+ }
+ while (corpus_size < CORPUS_MAX && fgets(corpus[corpus_size], TEXT_MAX, file) != NULL) {
+    size_t len = strlen(corpus[corpus_size]);
+    if (len == 0) continue;
+    if (corpus[corpus_size][len - 1] != '\n') {
+       if (len == TEXT_MAX - 1) len--;
+       corpus[corpus_size][len++] = '\n';
+       corpus[corpus_size][len] = '\0';
+    }
+    corpus_size++;
+ }
+ fclose(file);
+ if (corpus_size == 0) {
+    fprintf(stderr, "Corpus %s is empty\n", path);
+    exit(EXIT_FAILURE);
+ }
+}
+
+/*
+Exits if `plain` differs from message `i` of the corpus.
+*/
+static void check_round_trip(const int i, const uint8_t *plain)
+{
+ if (strcmp((const char *)plain, corpus[i]) != 0) {
+    fprintf(stderr, "Round trip failed for message %d: %s", i, corpus[i]);
+    exit(EXIT_FAILURE);
+ }
+}
+
+/*
+Exits if `size_a` bytes of `a` differ from `size_b` bytes of `b`, 
+outputs of message `i`.
+*/
+static void check_same(const int i, const char *what, const uint8_t *a, const uint32_t size_a, const uint8_t *b, const uint32_t size_b)
+{
+ if (size_a != size_b || memcmp(a, b, size_a) != 0) {
+    fprintf(stderr, "LZRW3-A16 differs from LZRW3-A(%s) for message %d: %s", what, i, corpus[i]);
+    exit(EXIT_FAILURE);
+ }
+}
+
+/*
+Checks LZRW3-A16 with 4096 entries against LZRW3-A on the corpus: every
+message alone(tables reset) and all of them in one history, like the
+stream mode. Outputs must be the same and every output is decompressed
+by the other implementation. Returns the number of checked messages.
+*/
+static int verify_lzrw3a16(void)
+{
+ /*Tables and histories: compressors, decompressor of LZRW3-A16 output 
+   by LZRW3-A(plain) and of LZRW3-A output by LZRW3-A16(plain16)*/
+ static uint8_t table[MEM_REQ], table_d[MEM_REQ];
+ static uint8_t table16[LZRW3A16_MEM(12)], table16_d[LZRW3A16_MEM(12)];
+ static uint8_t history[CORPUS_MAX * TEXT_MAX];
+ static uint8_t plain[CORPUS_MAX * TEXT_MAX], plain16[CORPUS_MAX * TEXT_MAX];
+ uint8_t out[COMPRESS_BOUND(TEXT_MAX)], out16[COMPRESS_BOUND(TEXT_MAX)];
+ uint32_t size, size16, plain_size;
+
+ for (int stream = NO; stream <= YES; stream++) {
+    uint32_t start = 0;
+    for (int i = 0; i < corpus_size; i++) {
+       uint32_t len = strlen(corpus[i]);
+       if (stream == NO || i == 0) {
+          start = 0;
+          lzrw3a_stream_reset(table);
+          lzrw3a_stream_reset(table_d);
+          lzrw3a16_init(table16, 12);
+          lzrw3a16_init(table16_d, 12);
+       }
+       memcpy(history + start, corpus[i], len);
+       lzrw3a_stream_compress(table, history + start, len, out, &size);
+       lzrw3a16_compress(table16, 12, history + start, len, out16, &size16, start);
+       check_same(i, "compress", out, size, out16, size16);
+
+       lzrw3a_stream_decompress(table_d, out16, size16, plain + start, sizeof(plain) - start, &plain_size);
+       check_same(i, "decompress", history + start, len, plain + start, plain_size);
+       lzrw3a16_decompress(table16_d, 12, out, size, plain16 + start, sizeof(plain16) - start, &plain_size, start);
+       check_same(i, "decompress", history + start, len, plain16 + start, plain_size);
+       start += len;
+    }
+ }
+ return 2 * corpus_size;
+}
+
+/*
+Compression of the whole corpus with the work memory allocated for every
+call of compress_text() and decompress_text(), like they did before the
+compression context with ALLOCATION == DYNAMIC.
+Returns cycles of BENCH_ROUNDS rounds.
+*/
+static uint64_t bench_per_call(const struct compress_backend *backend)
+{
+ uint8_t compr[MESSAGE_MAX];
+ uint8_t plain[BUFF_MAX];
+ struct compress_ctx ctx;
+ uint64_t start = bench_cycles();
+ for (int round = 0; round < BENCH_ROUNDS; round++) {
+    for (int i = 0; i < corpus_size; i++) {
+       uint32_t compr_size = 0;
+       compress_init_backend(&ctx, backend, NO);
+       compress_text(&ctx, (uint8_t *)corpus[i], BUFF_MAX, compr, &compr_size);
+       compress_free(&ctx);
+
+       compress_init_backend(&ctx, backend, NO);
+       memset(plain, 0, TEXT_MAX);
+       decompress_text(&ctx, compr, BUFF_MAX, plain, compr_size);
+       compress_free(&ctx);
+       check_round_trip(i, plain);
+    }
+ }
+ return bench_cycles() - start;
+}
+
+/*
+Messages and dictionary of a measurement: every `step`-th message of 
+the corpus from `first`, `dict` of `dict_size` bytes(NULL: none).
+*/
+struct bench_setup {
+ int first;
+ int step;
+ const uint8_t *dict;
+ uint32_t dict_size;
+};
+
+/*All messages, no dictionary*/
+static const struct bench_setup bench_all = {0, 1, NULL, 0};
+
+/*
+Results of the corpus sent in one session.
+*/
+struct bench_result {
+ uint64_t compress;   // Cycles of compress_text() in BENCH_ROUNDS rounds
+ uint64_t decompress; // Cycles of decompress_text() in BENCH_ROUNDS rounds
+ uint64_t compr;      // Compressed texts
+ uint64_t wire;       // Padded MACs, sizes and padded messages
+ int stored;          // Messages sent without compression
+};
+
+/*
+Compression of the messages of `setup` with one compression context per
+round(session), like chat() does. With `stream` == YES the messages are 
+compressed with the history of the session(as with COMPRESS_STREAM), otherwise
+every message alone. Sizes are of the first round.
+*/
+static void bench_session(const struct compress_backend *backend, const int stream, const struct bench_setup *setup, struct bench_result *result)
+{
+ uint8_t compr[MESSAGE_MAX];
+ uint8_t plain[BUFF_MAX];
+ struct compress_ctx ctx;
+ memset(result, 0, sizeof(*result));
+ for (int round = 0; round < BENCH_ROUNDS; round++) {
+    compress_init_backend(&ctx, backend, stream);
+    ctx.dict = setup->dict;
+    ctx.dict_size = setup->dict_size;
+    compress_reset(&ctx);
+    for (int i = setup->first; i < corpus_size; i += setup->step) {
+       uint32_t compr_size = 0;
+       uint64_t start = bench_cycles();
+       compress_text(&ctx, (uint8_t *)corpus[i], BUFF_MAX, compr + MESSAGE_OFFSET, &compr_size);
+       uint64_t middle = bench_cycles();
+       decompress_text(&ctx, compr + MESSAGE_OFFSET, BUFF_MAX, plain, compr_size);
+       result->decompress += bench_cycles() - middle;
+       result->compress += middle - start;
+       plain[strlen(corpus[i])] = '\0';
+       check_round_trip(i, plain);
+       if (round == 0) {
+          result->stored += compr[MESSAGE_OFFSET] == COMPRESS_STORED;
+          result->compr += compr_size;
+          result->wire += PADME_SIZE(MACSZ) + BYTE_ARRAY_SZ + pad_message(compr, compr_size);
+       }
+    }
+    compress_free(&ctx);
+ }
+}
+
+/*
+Best of BENCH_REPEAT runs of bench_session().
+*/
+static void bench_best(const struct compress_backend *backend, const int stream, const struct bench_setup *setup, struct bench_result *best)
+{
+ struct bench_result result;
+ bench_session(backend, stream, setup, best);
+ for (int i = 1; i < BENCH_REPEAT; i++) {
+    bench_session(backend, stream, setup, &result);
+    if (result.compress < best->compress) best->compress = result.compress;
+    if (result.decompress < best->decompress) best->decompress = result.decompress;
+ }
+}
+
+/*
+Work memory of a context of `backend` with 32-bit pointers(RP2040), 
+only the hash table of LZRW3-A holds pointers.
+*/
+static unsigned long ram_32bit(const struct compress_backend *backend, const int stream)
+{
+ uint32_t mem = backend == &compress_lzrw3a ? 4096 * 4 + 16 : backend->mem;
+ return (unsigned long)COMPRESS_STREAM_MEM(mem, stream);
+}
+
+int main(int argc, char **argv)
+{
+ const struct compress_backend *backends[] = {&compress_lzrw3a, &compress_lzrw3a16, &compress_lzss};
+ const int backend_count = sizeof(backends) / sizeof(backends[0]);
+ /*Both modes, the context is set up per run(not by COMPRESS_STREAM)*/
+ const int streams[] = {NO, YES};
+ const int stream_count = 2;
+ corpus_load(argc > 1 ? argv[1] : CHAT_CORPUS);
+
+ uint64_t plain_bytes = 0;
+ for (int i = 0; i < corpus_size; i++) plain_bytes += strlen(corpus[i]);
+ double messages = (double)corpus_size * BENCH_ROUNDS;
+
+ printf("clock: %s, ALLOCATION=%d, COMPRESS_MIN=%d, corpus: %d messages, %llu B\n",
+        BENCH_CLOCK, ALLOCATION, COMPRESS_MIN, corpus_size,
+        (unsigned long long)plain_bytes);
+ printf("LZRW3-A16(4096 entries) = LZRW3-A: %d messages alone and in one history, "
+        "cross decompressed\n", verify_lzrw3a16());
+ printf("LZRW3-A16 table: %d entries(LZRW3A16_TABLE_BITS)\n", 1 << LZRW3A16_TABLE_BITS);
+ printf("%-9s %-8s %8s %8s %9s %10s %10s %8s %7s\n", "backend", "history",
+        "RAM B", "RAM 32b", "compress", "decompress", "compressed", "wire", "stored");
+ for (int b = 0; b < backend_count; b++) {
+    for (int m = 0; m < stream_count; m++) {
+       struct bench_result result;
+       unsigned long ram = (unsigned long)COMPRESS_STREAM_MEM(backends[b]->mem, streams[m]);
+       bench_best(backends[b], streams[m], &bench_all, &result);
+       printf("%-9s %-8s %8lu %8lu %9.0f %10.0f %10llu %8llu %7d\n",
+              backends[b]->name, streams[m] == YES ? "session" : "none", ram,
+              ram_32bit(backends[b], streams[m]), (double)result.compress / messages,
+              (double)result.decompress / messages, (unsigned long long)result.compr,
+              (unsigned long long)result.wire, result.stored);
+    }
+ }
+ printf("(cycles per message, bytes of the whole corpus, no dictionary)\n");
+
+ /*Dictionary of the same size trained on the even lines only*/
+ static uint8_t trained[65536 + COMPRESS_DICT_PAD];
+ static const char *even[CORPUS_MAX];
+ int even_count = 0;
+ for (int i = 0; i < corpus_size; i += 2) even[even_count++] = corpus[i];
+ uint32_t trained_size = dict_train(even, even_count, trained, compress_dict_size);
+ const struct bench_setup setups[] = {
+    {0, 1, NULL, 0}, {0, 1, compress_dict, compress_dict_size},
+    {1, 2, NULL, 0}, {1, 2, trained, trained_size}
+ };
+ const char *setup_names[] = {"none", "compress_dict.c", "none", "even lines"};
+ printf("\nLZRW3-A dictionary(COMPRESS_DICT), %lu B built-in, %lu B trained\n",
+        (unsigned long)compress_dict_size, (unsigned long)trained_size);
+ printf("%-5s %-15s %-8s %9s %10s %10s %8s %7s %7s\n", "lines", "dictionary", "history",
+        "compress", "decompress", "compressed", "wire", "saved", "stored");
+ for (int m = 0; m < stream_count; m++) {
+    struct bench_result none = {0}; // Setup without dictionary comes first
+    for (int d = 0; d < 4; d++) {
+       struct bench_result result;
+       double count = (double)((corpus_size - setups[d].first + setups[d].step - 1) / setups[d].step) * BENCH_ROUNDS;
+       bench_best(&compress_lzrw3a, streams[m], &setups[d], &result);
+       if (setups[d].dict == NULL) none = result;
+       printf("%-5s %-15s %-8s %9.0f %10.0f %10llu %8llu %7lld %7d\n",
+              setups[d].first == 0 ? "all" : "odd", setup_names[d],
+              streams[m] == YES ? "session" : "none",
+              (double)result.compress / count, (double)result.decompress / count,
+              (unsigned long long)result.compr, (unsigned long long)result.wire,
+              (long long)none.wire - (long long)result.wire, result.stored);
+    }
+ }
+ printf("(saved: wire bytes against no dictionary on the same lines)\n");
+
+ /*Default backend: work memory per call against per session*/
+ const struct compress_backend *backend = COMPRESS_BACKEND == LZSS ? &compress_lzss :
+                                          COMPRESS_BACKEND == LZRW3A16 ? &compress_lzrw3a16 : &compress_lzrw3a;
+ struct bench_result session;
+ uint64_t per_call_best = UINT64_MAX;
+ for (int i = 0; i < BENCH_REPEAT; i++) {
+    uint64_t cycles = bench_per_call(backend);
+    if (cycles < per_call_best) per_call_best = cycles;
+ }
+ bench_best(backend, NO, &bench_all, &session);
+ double per_call = (double)per_call_best / messages;
+ double per_session = (double)(session.compress + session.decompress) / messages;
+ printf("\n%s(COMPRESS_BACKEND), no history     %14s\n", backend->name, "cycles/message");
+ printf("%-36s %14.0f\n", "work memory allocated per call", per_call);
+ printf("%-36s %14.0f\n", "compression context per session", per_session);
+ return 0;
+}
@@ -0,0 +1,374 @@
+// Client-server API(PICO)        //
+// Crypto benchmark               //
+// Version 0.9.1pi                //
+// Bachelor's Work Project        //
+// Technical University of Kosice //
+// 17.10.2026                     //
+// Nikita Kuropatkin              //
+// Host tools for                 //
+// W5100S-EVB-Pico                //
+
+/*
+Micro-benchmark of the Monocypher calls the client makes, with the
+sizes the client uses:
+- key_hidden(): crypto_x25519_dirty_fast, crypto_elligator_rev,
+- key_exc_ell(): crypto_elligator_map, crypto_x25519(kdf),
+  crypto_blake2b_keyed(MAC of 32 byte key),
+- chat(): crypto_aead_write/crypto_aead_read on 1..BUFF_MAX bytes,
+- pin_checker(): crypto_argon2 with BLOCK_AMOUNT/ITERATIONS,
+  argon2_lanes() with lanes filled by both cores(threads on host),
+  checked to give the same hash as crypto_argon2() for 1, 2 and 4 lanes,
+- random_num(): Keccak-f[1600] of XDRBG with 64-bit lanes and 32-bit
+  interleaved lanes(keccak_bi.c), checked against each other and
+  against known answers of XDRBG.
+On host the results are printed as JSON (or as a table with -t),
+on the board as a table over stdio.
+*/
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include "bench_cycles.h"
+#include "monocypher.h"
+#include "argon2_lanes.h"
+#include "keccak_bi.h"
+#include "xdrbg.h"
+#include "pico/multicore.h"
+#include "error.h"
+#include "parameters.h"
+
+/*
+In use: here.
+Calls per measurement, divided by BENCH_SLOW for heavy primitives.
+The board runs ~50x slower than the host, so fewer calls are made there.
+*/
+#if PICO_ON_DEVICE
+  #define BENCH_CALLS 20
+#else
+  #define BENCH_CALLS 2000
+#endif
+#define BENCH_SLOW 10
+
+/*Output format*/
+static int as_table = PICO_ON_DEVICE;
+static int first_result = YES;
+
+/*Inputs(fixed pseudo-random bytes, no DRBG needed)*/
+static uint8_t sk[KEYSZ];
+static uint8_t pk[KEYSZ];
+static uint8_t hidden[KEYSZ];
+static uint8_t key[KEYSZ];
+static uint8_t nonce[NONSZ];
+static uint8_t text[BUFF_MAX];
+static uint8_t cipher[BUFF_MAX];
+static uint8_t mac[MACSZ];
+
+/*
+Prints one result: `calls` calls of `name` on `bytes` bytes took `cycles`.
+*/
+static void bench_report(const char *name, const int bytes, const int calls, const uint64_t cycles)
+{
+ double per_call = (double)cycles / calls;
+ double per_byte = bytes > 0 ? per_call / bytes : 0.0;
+ if (as_table) {
+    printf("%-26s %6d %8d %14.0f %12.2f\n", name, bytes, calls, per_call, per_byte);
+ }
+ else {
+    printf("%s\n  {\"name\": \"%s\", \"bytes\": %d, \"calls\": %d, "
+           "\"cycles_per_call\": %.1f, \"cycles_per_byte\": %.3f}",
+           first_result == YES ? "" : ",", name, bytes, calls, per_call, per_byte);
+ }
+ first_result = NO;
+}
+
+static void bench_x25519_dirty_fast(void)
+{
+ const int calls = BENCH_CALLS / BENCH_SLOW;
+ uint64_t start = bench_cycles();
+ for (int i = 0; i < calls; i++) {
+    crypto_x25519_dirty_fast(pk, sk);
+ }
+ bench_report("crypto_x25519_dirty_fast", KEYSZ, calls, bench_cycles() - start);
+}
+
+static void bench_elligator(void)
+{
+ const int calls = BENCH_CALLS;
+ uint8_t curve[KEYSZ];
+ uint64_t start = bench_cycles();
+ for (int i = 0; i < calls; i++) {
+    crypto_elligator_rev(hidden, pk, (uint8_t)i);
+ }
+ bench_report("crypto_elligator_rev", KEYSZ, calls, bench_cycles() - start);
+
+ start = bench_cycles();
+ for (int i = 0; i < calls; i++) {
+    crypto_elligator_map(curve, hidden);
+ }
+ bench_report("crypto_elligator_map", KEYSZ, calls, bench_cycles() - start);
+}
+
+static void bench_x25519(void)
+{
+ const int calls = BENCH_CALLS / BENCH_SLOW;
+ uint8_t shared[KEYSZ];
+ uint64_t start = bench_cycles();
+ for (int i = 0; i < calls; i++) {
+    crypto_x25519(shared, sk, pk);
+ }
+ bench_report("crypto_x25519", KEYSZ, calls, bench_cycles() - start);
+}
+
+static void bench_blake2b_keyed(void)
+{
+ const int calls = BENCH_CALLS;
+ uint64_t start = bench_cycles();
+ for (int i = 0; i < calls; i++) {
+    crypto_blake2b_keyed(mac, MACSZ, key, KEYSZ, text, KEYSZ);
+ }
+ bench_report("crypto_blake2b_keyed", KEYSZ, calls, bench_cycles() - start);
+}
+
+/*
+AEAD on 1, 2, 4, ... 256, TEXT_MAX and BUFF_MAX bytes.
+*/
+static void bench_aead(void)
+{
+ const int calls = BENCH_CALLS;
+ int sizes[16];
+ int count = 0;
+ for (int size = 1; size < TEXT_MAX; size *= 2) sizes[count++] = size;
+ sizes[count++] = TEXT_MAX;
+ sizes[count++] = BUFF_MAX;
+
+ for (int i = 0; i < count; i++) {
+    crypto_aead_ctx ctx_us;
+    crypto_aead_ctx ctx_thm;
+    crypto_aead_init_x(&ctx_us, key, nonce);
+    crypto_aead_init_x(&ctx_thm, key, nonce);
+
+    /*Writing is timed alone, reading gets the frames it must accept*/
+    uint64_t write_cycles = 0;
+    uint64_t read_cycles = 0;
+    for (int j = 0; j < calls; j++) {
+       uint64_t start = bench_cycles();
+       crypto_aead_write(&ctx_us, cipher, mac, NULL, 0, text, sizes[i]);
+       write_cycles += bench_cycles() - start;
+
+       start = bench_cycles();
+       if (crypto_aead_read(&ctx_thm, text, mac, NULL, 0, cipher, sizes[i]) != OK) {
+          printf("AEAD frame rejected\n");
+          exit(EXIT_FAILURE);
+       }
+       read_cycles += bench_cycles() - start;
+    }
+    bench_report("crypto_aead_write", sizes[i], calls, write_cycles);
+    bench_report("crypto_aead_read", sizes[i], calls, read_cycles);
+ }
+}
+
+/*
+Argon2i exactly as in hashing_pin(), cycles per byte are per byte of
+work area (BLOCK_AMOUNT KB) and pass.
+*/
+static void bench_argon2(void)
+{
+ const int calls = PICO_ON_DEVICE ? 1 : 5;
+ uint8_t hash[HASHSZ];
+ crypto_argon2_config config = {
+    .algorithm = CRYPTO_ARGON2_I,
+    .nb_blocks = BLOCK_AMOUNT,
+    .nb_passes = ITERATIONS,
+    .nb_lanes  = LANSES
+ };
+ crypto_argon2_inputs inputs = {
+    .pass      = text,
+    .salt      = key,
+    .pass_size = PINSZ,
+    .salt_size = SALTSZ
+ };
+ void *work_area = malloc((size_t)BLOCK_AMOUNT * 1024);
+ if (work_area == NULL) {
+    printf("Memory allocation failed\n");
+    exit(EXIT_FAILURE);
+ }
+ uint64_t start = bench_cycles();
+ for (int i = 0; i < calls; i++) {
+    crypto_argon2(hash, HASHSZ, work_area, config, inputs, crypto_argon2_no_extras);
+ }
+ uint64_t cycles = bench_cycles() - start;
+ free(work_area);
+ bench_report("crypto_argon2", BLOCK_AMOUNT * 1024 * ITERATIONS, calls, cycles);
+}
+
+/*
+Second core only helps argon2_lanes() on the first core.
+*/
+static uint32_t core1_stack[CORE1_STACK_SIZE / sizeof(uint32_t)];
+
+static void bench_core1(void)
+{
+ while (1) {
+    argon2_lanes_help();
+ }
+}
+
+/*
+Checks that argon2_lanes() on two cores gives the same hash as
+crypto_argon2() for 1, 2 and 4 lanes(stops the benchmark if not), 
+then compares both for 2 lanes with 8 * 2 KB and ITERATIONS passes.
+*/
+static void bench_argon2_lanes(void)
+{
+ const int calls = PICO_ON_DEVICE ? 1 : 5;
+ const uint32_t lanes[] = {1, 2, 4};
+ uint8_t hash[HASHSZ];
+ uint8_t hash_lanes[HASHSZ];
+ crypto_argon2_inputs inputs = {
+    .pass      = text,
+    .salt      = key,
+    .pass_size = PINSZ,
+    .salt_size = SALTSZ
+ };
+ void *work_area = malloc((size_t)8 * 4 * 1024);
+ if (work_area == NULL) {
+    printf("Memory allocation failed\n");
+    exit(EXIT_FAILURE);
+ }
+ multicore_launch_core1_with_stack(bench_core1, core1_stack, sizeof(core1_stack));
+
+ for (size_t i = 0; i < sizeof(lanes) / sizeof(lanes[0]); i++) {
+    crypto_argon2_config config = {
+       .algorithm = CRYPTO_ARGON2_I,
+       .nb_blocks = 8 * lanes[i] + 5, // Not a multiple of 4 * lanes
+       .nb_passes = 3,
+       .nb_lanes  = lanes[i]
+    };
+    crypto_argon2(hash, HASHSZ, work_area, config, inputs, crypto_argon2_no_extras);
+    argon2_lanes(hash_lanes, HASHSZ, work_area, config, inputs, crypto_argon2_no_extras);
+    if (memcmp(hash, hash_lanes, HASHSZ) != 0) {
+       printf("argon2_lanes differs from crypto_argon2 for %lu lanes\n", (unsigned long)lanes[i]);
+       exit(EXIT_FAILURE);
+    }
+ }
+
+ crypto_argon2_config config = {
+    .algorithm = CRYPTO_ARGON2_I,
+    .nb_blocks = 8 * 2,
+    .nb_passes = ITERATIONS,
+    .nb_lanes  = 2
+ };
+ uint64_t start = bench_cycles();
+ for (int i = 0; i < calls; i++) {
+    crypto_argon2(hash, HASHSZ, work_area, config, inputs, crypto_argon2_no_extras);
+ }
+ bench_report("crypto_argon2(2 lanes)", 8 * 2 * 1024 * ITERATIONS, calls, bench_cycles() - start);
+
+ start = bench_cycles();
+ for (int i = 0; i < calls; i++) {
+    argon2_lanes(hash_lanes, HASHSZ, work_area, config, inputs, crypto_argon2_no_extras);
+ }
+ bench_report("argon2_lanes(2 lanes)", 8 * 2 * 1024 * ITERATIONS, calls, bench_cycles() - start);
+ free(work_area);
+}
+
+/*
+Known answer of XDRBG(original 64-bit Keccak): seeded with bytes 0..63,
+then 48 and 32 bytes generated.
+*/
+static const uint8_t xdrbg_kat[48 + 32] = {
+ 0x6e, 0xd4, 0xa7, 0x9f, 0x41, 0x27, 0xbd, 0x09, 0xca, 0x18, 0xa8, 0xc1,
+ 0x43, 0xbd, 0x95, 0x8d, 0x3a, 0x3d, 0x8a, 0x22, 0xa0, 0xae, 0xca, 0xca,
+ 0xf4, 0x07, 0xb7, 0xd2, 0x18, 0x93, 0x3b, 0x6d, 0x7c, 0x82, 0x93, 0x06,
+ 0x25, 0xbf, 0xf2, 0x5e, 0x28, 0x5a, 0xa1, 0x7b, 0x46, 0x2c, 0xc6, 0x53,
+ 0xbc, 0xe1, 0x41, 0x5a, 0x20, 0x5b, 0x1e, 0x5a, 0xda, 0xed, 0xf8, 0x81,
+ 0x3f, 0x38, 0x4d, 0x6b, 0x07, 0xe4, 0x52, 0x85, 0x9f, 0xf7, 0x3a, 0xdc,
+ 0x04, 0x02, 0x7d, 0x8d, 0x8c, 0xd4, 0xfc, 0xe7
+};
+
+/*
+Checks XDRBG(with the backend chosen by KECCAK_BACKEND) against the known 
+answer and keccakp_1600_bi() against keccakp_1600_64() on chained states
+(stops the benchmark if not), then compares cycles of both permutations.
+*/
+static void bench_keccak(void)
+{
+ const int calls = BENCH_CALLS;
+ struct lc_xdrbg256_drng_state drbg = { 0 };
+ uint8_t seed[SEED_SIZE];
+ uint8_t out[sizeof(xdrbg_kat)];
+ for (int i = 0; i < SEED_SIZE; i++) seed[i] = (uint8_t)i;
+ lc_xdrbg256_drng_seed(&drbg, seed, SEED_SIZE);
+ lc_xdrbg256_drng_generate(&drbg, out, 48);
+ lc_xdrbg256_drng_generate(&drbg, &out[48], 32);
+ if (memcmp(out, xdrbg_kat, sizeof(xdrbg_kat)) != 0) {
+    printf("XDRBG differs from the known answer(KECCAK_BACKEND %d)\n", KECCAK_BACKEND);
+    exit(EXIT_FAILURE);
+ }
+
+ uint64_t state[25];
+ uint64_t state_bi[25];
+ for (int i = 0; i < 25; i++) {
+    state[i] = (uint64_t)(i * 0x9E3779B97F4A7C15ULL);
+ }
+ memcpy(state_bi, state, sizeof(state));
+ for (int i = 0; i < 100; i++) {
+    keccakp_1600_64(state);
+    keccakp_1600_bi(state_bi);
+    if (memcmp(state, state_bi, sizeof(state)) != 0) {
+       printf("keccakp_1600_bi differs from keccakp_1600_64(call %d)\n", i);
+       exit(EXIT_FAILURE);
+    }
+ }
+
+ uint64_t start = bench_cycles();
+ for (int i = 0; i < calls; i++) keccakp_1600_64(state);
+ uint64_t cycles = bench_cycles() - start;
+ bench_report("keccakp_1600_64", 200, calls, cycles);
+
+ start = bench_cycles();
+ for (int i = 0; i < calls; i++) keccakp_1600_bi(state);
+ cycles = bench_cycles() - start;
+ bench_report("keccakp_1600_bi", 200, calls, cycles);
+}
+
+int main(int argc, char **argv)
+{
+#if PICO_ON_DEVICE
+ (void)argc;
+ (void)argv;
+ set_sys_clock_khz(PLL_SYS_KHZ, true);
+ stdio_init_all();
+ sleep_ms(3000); // Time to open the terminal
+#else
+ if (argc > 1 && strcmp(argv[1], "-t") == 0) as_table = YES;
+#endif
+
+ for (int i = 0; i < KEYSZ; i++) {
+    sk[i] = (uint8_t)(i * 7 + 1);
+    key[i] = (uint8_t)(i * 13 + 5);
+ }
+ for (int i = 0; i < NONSZ; i++) nonce[i] = (uint8_t)(i * 3);
+ for (int i = 0; i < BUFF_MAX; i++) text[i] = (uint8_t)('a' + i % 26);
+ crypto_x25519_dirty_fast(pk, sk);
+
+ if (as_table) {
+    printf("clock: %s, BLOCK_AMOUNT=%d ITERATIONS=%d\n", BENCH_CLOCK, BLOCK_AMOUNT, ITERATIONS);
+    printf("%-26s %6s %8s %14s %12s\n", "primitive", "bytes", "calls", "cycles/call", "cycles/byte");
+ }
+ else {
+    printf("{\"clock\": \"%s\", \"block_amount\": %d, \"iterations\": %d, \"results\": [",
+           BENCH_CLOCK, BLOCK_AMOUNT, ITERATIONS);
+ }
+
+ bench_x25519_dirty_fast();
+ bench_elligator();
+ bench_x25519();
+ bench_blake2b_keyed();
+ bench_aead();
+ bench_argon2();
+ bench_argon2_lanes();
+ bench_keccak();
+
+ if (!as_table) printf("\n]}\n");
+ return 0;
+}
@@ -0,0 +1,48 @@
+// Client-server API(PICO)        //
+// Benchmark cycle counter        //
+// Version 0.9.1pi                //
+// Bachelor's Work Project        //
+// Technical University of Kosice //
+// 17.10.2026                     //
+// Nikita Kuropatkin              //
+// Host tools for                 //
+// W5100S-EVB-Pico                //
+
+/*
+This header file defines the cycle counter used by the benchmarks.
+- RP2040: Cortex-M0+ has no cycle counter(no DWT), so the 1 MHz system
+  timer is scaled by clk_sys frequency.
+- x86 host: time stamp counter(reference cycles, not turbo cycles).
+- Other hosts: monotonic clock in nanoseconds (BENCH_CLOCK says "ns").
+*/
+#ifndef BENCH_CYCLES_H
+#define BENCH_CYCLES_H
+#include <stdint.h>
+
+#if PICO_ON_DEVICE
+  #include "pico/stdlib.h"
+  #include "hardware/clocks.h"
+  #define BENCH_CLOCK "clk_sys"
+  static inline uint64_t bench_cycles(void)
+  {
+   return time_us_64() * (clock_get_hz(clk_sys) / 1000000u);
+  }
+#elif defined(__x86_64__) || defined(__i386__)
+  #include <x86intrin.h>
+  #define BENCH_CLOCK "rdtsc"
+  static inline uint64_t bench_cycles(void)
+  {
+   return __rdtsc();
+  }
+#else
+  #include <time.h>
+  #define BENCH_CLOCK "ns"
+  static inline uint64_t bench_cycles(void)
+  {
+   struct timespec ts;
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+   return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+  }
+#endif
+
+#endif
@@ -0,0 +1,134 @@
+// Client-server API(PICO)        //
+// Dictionary builder             //
+// Version 0.9.1pi                //
+// Bachelor's Work Project        //
+// Technical University of Kosice //
+// 17.10.2026                     //
+// Nikita Kuropatkin              //
+// Host tools for                 //
+// W5100S-EVB-Pico                //
+
+/*
+Builds the compression dictionary(COMPRESS_DICT) from a corpus of chat
+lines(one message per line) and writes it as C source, which replaces
+src/compress_dict.c. The client and the server must be built with the
+same file. The corpus should be typical traffic, the dictionary only 
+helps messages which share strings with it.
+Usage: dict_build <corpus file> <output .c file> [size, default DICT_SIZE]
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "dict_train.h"
+#include "compress_dict.h"
+#include "parameters.h"
+
+/*
+In use: here.
+Default size of the dictionary. Every byte is a position in the hash 
+table of LZRW3-A(4096 entries), a bigger one pushes out more of itself.
+*/
+#define DICT_SIZE 1024
+
+/*Corpus: messages with terminating '\n', as sent by the client*/
+#define CORPUS_MAX 4096
+static char corpus[CORPUS_MAX][TEXT_MAX];
+static const char *lines[CORPUS_MAX];
+
+/*
+Reads one message per line of `path`, too long lines are cut to TEXT_MAX.
+Returns the number of lines.
+*/
+static int corpus_load(const char *path)
+{
+ int count = 0;
+ FILE *file = fopen(path, "r");
+ if (file == NULL) {
+    perror(path);
+    exit(EXIT_FAILURE);
+ }
+ while (count < CORPUS_MAX && fgets(corpus[count], TEXT_MAX, file) != NULL) {
+    size_t len = strlen(corpus[count]);
+    if (len == 0) continue;
+    if (corpus[count][len - 1] != '\n') {
+       if (len == TEXT_MAX - 1) len--;
+       corpus[count][len++] = '\n';
+       corpus[count][len] = '\0';
+    }
+    lines[count] = corpus[count];
+    count++;
+ }
+ fclose(file);
+ return count;
+}
+
+/*
+Writes `size` bytes of `dict` as C source to `path`(CRLF like the other
+sources): string literals broken after every '\n' and at 64 bytes.
+*/
+static void dict_write(const char *path, const char *corpus_path, const uint8_t *dict, const uint32_t size)
+{
+ FILE *file = fopen(path, "wb");
+ if (file == NULL) {
+    perror(path);
+    exit(EXIT_FAILURE);
+ }
+ const char *name = strrchr(corpus_path, '/');
+ name = name == NULL ? corpus_path : name + 1;
+ fprintf(file,
+         "// Client-server API(PICO)        //\r\n"
+         "// Compression dictionary         //\r\n"
+         "// Version 0.9.1pi                //\r\n"
+         "// Bachelor's Work Project        //\r\n"
+         "// Technical University of Kosice //\r\n"
+         "// 17.10.2026                     //\r\n"
+         "// Nikita Kuropatkin              //\r\n"
+         "// Version for MCU                //\r\n"
+         "// W5100S-EVB-Pico                //\r\n"
+         "\r\n"
+         "/*\r\n"
+         "Generated by dict_build(bench/dict_build.c) from %s, do not edit.\r\n"
+         "Constant data stays in flash(XIP on RP2040), see compress_dict.h.\r\n"
+         "*/\r\n"
+         "#include <stdint.h>\r\n"
+         "#include \"include/compress_dict.h\"\r\n"
+         "\r\n"
+         "const uint32_t compress_dict_size = %lu;\r\n"
+         "\r\n"
+         "const uint8_t compress_dict[%lu + COMPRESS_DICT_PAD] =\r\n",
+         name, (unsigned long)size, (unsigned long)size);
+ uint32_t column = 0;
+ for (uint32_t i = 0; i < size; i++) {
+    uint8_t c = dict[i];
+    if (column == 0) fputs(" \"", file);
+    if (c == '\n') column += fprintf(file, "\\n");
+    else if (c == '"' || c == '\\' || c == '?') column += fprintf(file, "\\%c", c);
+    else if (c < 0x20 || c > 0x7E) column += fprintf(file, "\\%03o", c);
+    else column += fprintf(file, "%c", c);
+    if (c == '\n' || column >= 64 || i + 1 == size) {
+       fputs(i + 1 == size ? "\";\r\n" : "\"\r\n", file);
+       column = 0;
+    }
+ }
+ if (size == 0) fputs(" \"\";\r\n", file);
+ fclose(file);
+}
+
+int main(int argc, char **argv)
+{
+ static uint8_t dict[65536];
+ if (argc < 3) {
+    fprintf(stderr, "Usage: %s <corpus file> <output .c file> [size]\n", argv[0]);
+    return EXIT_FAILURE;
+ }
+ long max = argc > 3 ? strtol(argv[3], NULL, 10) : DICT_SIZE;
+ if (max <= 0 || max > (long)sizeof(dict)) {
+    fprintf(stderr, "Size must be 1 to %lu bytes\n", (unsigned long)sizeof(dict));
+    return EXIT_FAILURE;
+ }
+ int count = corpus_load(argv[1]);
+ uint32_t size = dict_train(lines, count, dict, (uint32_t)max);
+ dict_write(argv[2], argv[1], dict, size);
+ printf("%s: %lu B dictionary from %d lines\n", argv[2], (unsigned long)size, count);
+ return 0;
+}
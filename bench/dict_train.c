@@ -0,0 +1,109 @@
+// Client-server API(PICO)        //
+// Dictionary training            //
+// Version 0.9.1pi                //
+// Bachelor's Work Project        //
+// Technical University of Kosice //
+// 17.10.2026                     //
+// Nikita Kuropatkin              //
+// Host tools for                 //
+// W5100S-EVB-Pico                //
+
+#include <stdlib.h>
+#include <string.h>
+#include "dict_train.h"
+
+#define DICT_HASH_SIZE (1 << DICT_HASH_BITS)
+
+/*
+Hash of DICT_K bytes at `p` to the index of its counter.
+*/
+static uint32_t dict_hash(const uint8_t *p)
+{
+ uint32_t h = 2166136261u;
+ for (int i = 0; i < DICT_K; i++) {
+    h = (h ^ p[i]) * 16777619u;
+ }
+ return h >> (32 - DICT_HASH_BITS);
+}
+
+/*
+Sum of counters of k-mers of `len` bytes at `p`.
+*/
+static uint32_t dict_score(const uint32_t *freq, const uint8_t *p, const uint32_t len)
+{
+ uint32_t score = 0;
+ for (uint32_t i = 0; i + DICT_K <= len; i++) {
+    score += freq[dict_hash(p + i)];
+ }
+ return score;
+}
+
+uint32_t dict_train(const char *const *lines, const int count, uint8_t *dict, const uint32_t max)
+{
+ /*Lines which contain a k-mer, last line counted(every line once)*/
+ uint32_t *freq = calloc(DICT_HASH_SIZE, sizeof(uint32_t));
+ int *last = malloc(DICT_HASH_SIZE * sizeof(int));
+ uint32_t size = 0;
+ if (freq == NULL || last == NULL) {
+    free(freq);
+    free(last);
+    return 0;
+ }
+ for (uint32_t h = 0; h < DICT_HASH_SIZE; h++) last[h] = -1;
+ for (int i = 0; i < count; i++) {
+    const uint8_t *line = (const uint8_t *)lines[i];
+    uint32_t len = strlen(lines[i]);
+    for (uint32_t j = 0; j + DICT_K <= len; j++) {
+       uint32_t h = dict_hash(line + j);
+       if (last[h] != i) {
+          last[h] = i;
+          freq[h]++;
+       }
+    }
+ }
+ /*A k-mer of one line saves nothing on other lines*/
+ for (uint32_t h = 0; h < DICT_HASH_SIZE; h++) {
+    if (freq[h] < 2) freq[h] = 0;
+ }
+
+ /*Strings are taken from the best down and written from the end*/
+ while (size < max) {
+    const uint8_t *best = NULL;
+    uint32_t best_len = 0;
+    uint32_t best_score = 0;
+    for (int i = 0; i < count; i++) {
+       const uint8_t *line = (const uint8_t *)lines[i];
+       uint32_t len = strlen(lines[i]);
+       for (uint32_t j = 0; j + DICT_K <= len; j++) {
+          uint32_t seg = len - j < DICT_SEGMENT ? len - j : DICT_SEGMENT;
+          uint32_t score = dict_score(freq, line + j, seg);
+          if (score > best_score) {
+             best = line + j;
+             best_len = seg;
+             best_score = score;
+          }
+       }
+    }
+    if (best == NULL) {
+       break;
+    }
+    /*Bytes after the last counted k-mer are not worth it*/
+    while (best_len > DICT_K && freq[dict_hash(best + best_len - DICT_K)] == 0) {
+       best_len--;
+    }
+    if (best_len > max - size) {
+       best = best + best_len - (max - size);
+       best_len = max - size;
+    }
+    for (uint32_t i = 0; i + DICT_K <= best_len; i++) {
+       freq[dict_hash(best + i)] = 0;
+    }
+    size += best_len;
+    memcpy(dict + max - size, best, best_len);
+ }
+ /*Taken strings to the start of `dict`*/
+ memmove(dict, dict + max - size, size);
+ free(freq);
+ free(last);
+ return size;
+}
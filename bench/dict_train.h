@@ -0,0 +1,42 @@
+// Client-server API(PICO)        //
+// Dictionary training            //
+// Version 0.9.1pi                //
+// Bachelor's Work Project        //
+// Technical University of Kosice //
+// 17.10.2026                     //
+// Nikita Kuropatkin              //
+// Host tools for                 //
+// W5100S-EVB-Pico                //
+
+/*
+This header file declares the training of the compression dictionary
+(COMPRESS_DICT) from a corpus of chat lines, used by dict_build and 
+bench_compress. Function bodies are in dict_train.c.
+*/
+#ifndef DICT_TRAIN_H
+#define DICT_TRAIN_H
+#include <stdint.h>
+
+/*
+Parameters of the training:
+- DICT_K: Length of the substrings(k-mers) which are counted, a string
+  of the dictionary is worth the lines its k-mers occur in.
+- DICT_SEGMENT: The longest string taken from a line at once.
+- DICT_HASH_BITS: log2 of counters, k-mers share them by hash.
+*/
+#define DICT_K 6
+#define DICT_SEGMENT 32
+#define DICT_HASH_BITS 16
+
+/*
+The function builds a dictionary of at most `max` bytes from `count` 
+lines of `lines` and writes it to `dict`, returns its size.
+Strings of the lines are taken greedily by the number of other lines 
+which share their k-mers(k-mers of taken strings are not counted 
+again), until the dictionary is full or no k-mer is in two lines.
+The best strings are at the end of the dictionary, the hash table of 
+LZRW3-A keeps the last positions.
+*/
+uint32_t dict_train(const char *const *lines, const int count, uint8_t *dict, const uint32_t max);
+
+#endif
@@ -0,0 +1,348 @@
+// Client-server API(PICO)        //
+// Reference server               //
+// Version 0.9.1pi                //
+// Bachelor's Work Project        //
+// Technical University of Kosice //
+// 17.10.2026                     //
+// Nikita Kuropatkin              //
+// Host tools for                 //
+// W5100S-EVB-Pico                //
+
+/*
+Reference server for the Linux host build. It is the mirror image of
+key_exc_ell() and chat() in client.c, see ReadME.txt (algorithm part)
+for the description of the protocol.
+*/
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include "server.h"
+#include "monocypher.h"
+#include "crypto.h"
+#include "random.h"
+#include "compress_decompress.h"
+#include "error.h"
+#include "parameters.h"
+
+//////////////////////////////////////////
+/// Socket helpers ///
+//////////////////////////////////////////
+/*
+Reads exactly `size` bytes. Returns OK or RETURN_ERROR on lost connection.
+*/
+static int server_read(const int fd, uint8_t *msg, const size_t size)
+{
+ size_t done = 0;
+ while (done < size) {
+    ssize_t retval = recv(fd, msg + done, size - done, 0);
+    if (retval < 0 && errno == EINTR) continue;
+    if (retval <= 0) return RETURN_ERROR;
+    done += (size_t)retval;
+ }
+ return OK;
+}
+
+/*
+Writes exactly `size` bytes. Returns OK or RETURN_ERROR on lost connection.
+*/
+static int server_write(const int fd, const uint8_t *msg, const size_t size)
+{
+ size_t done = 0;
+ while (done < size) {
+    ssize_t retval = send(fd, msg + done, size - done, MSG_NOSIGNAL);
+    if (retval < 0 && errno == EINTR) continue;
+    if (retval <= 0) return RETURN_ERROR;
+    done += (size_t)retval;
+ }
+ return OK;
+}
+
+/*
+Same as server_read(), but ends the program if the connection is lost.
+*/
+static void server_read_or_exit(const int fd, uint8_t *msg, const size_t size)
+{
+ if (server_read(fd, msg, size) != OK) {
+    exit_with_error(ERROR_RECEIVING_DATA, "Recieving failed");
+ }
+}
+
+/*
+Same as server_write(), but ends the program if the connection is lost.
+*/
+static void server_write_or_exit(const int fd, const uint8_t *msg, const size_t size)
+{
+ if (server_write(fd, msg, size) != OK) {
+    exit_with_error(ERROR_SENDING_DATA, "Writing failed");
+ }
+}
+//////////////////////////////////////////
+//////////////////////////////////////////
+
+uint64_t server_now_us(void)
+{
+ struct timespec ts;
+ clock_gettime(CLOCK_MONOTONIC, &ts);
+ return (uint64_t)ts.tv_sec * 1000000u + (uint64_t)ts.tv_nsec / 1000u;
+}
+
+//////////////////////////////////////////
+/// Flash provisioning ///
+//////////////////////////////////////////
+void server_provision(const char *flash_path, uint8_t *plain_key)
+{
+ uint8_t salt[SALTSZ];
+ uint8_t hashed_pin[HASHSZ];
+ uint8_t secured_key[KEYSZ];
+
+ random_num(plain_key, KEYSZ);
+ random_num(salt, SALTSZ);
+
+ /*Same Argon2i configuration as hashing_pin() in pin.c*/
+ crypto_argon2_config config = {
+    .algorithm = CRYPTO_ARGON2_I,
+    .nb_blocks = BLOCK_AMOUNT,
+    .nb_passes = ITERATIONS,
+    .nb_lanes  = LANSES
+ };
+ crypto_argon2_inputs inputs = {
+    .pass      = (const uint8_t *)SERVER_PIN,
+    .salt      = salt,
+    .pass_size = PINSZ,
+    .salt_size = SALTSZ
+ };
+ void *work_area = malloc((size_t)BLOCK_AMOUNT * 1024);
+ if (work_area == NULL) {
+    exit_with_error(ALLOCATION_ERROR, "Memory allocation failed");
+ }
+ crypto_argon2(hashed_pin, HASHSZ, work_area, config, inputs, crypto_argon2_no_extras);
+ free(work_area);
+
+ for (int i = 0; i < KEYSZ; i++) {
+    secured_key[i] = plain_key[i] ^ hashed_pin[i];
+ }
+ crypto_wipe(hashed_pin, HASHSZ);
+
+ /*Erased image with key and salt at the beginning of FLASH_PAGE*/
+ static uint8_t image[PICO_FLASH_SIZE_BYTES];
+ memset(image, 0xFF, sizeof(image));
+ memcpy(&image[FLASH_PAGE + KEY_OFFSET], secured_key, KEYSZ);
+ memcpy(&image[FLASH_PAGE + SALT_OFFSET], salt, SALTSZ);
+
+ FILE *file = fopen(flash_path, "wb");
+ if (file == NULL || fwrite(image, 1, sizeof(image), file) != sizeof(image)) {
+    exit_with_error(ERROR_FLASH, "Error writing flash image");
+ }
+ fclose(file);
+}
+//////////////////////////////////////////
+//////////////////////////////////////////
+
+int server_listen(const int port)
+{
+ int fd = socket(AF_INET, SOCK_STREAM, 0);
+ if (fd < 0) {
+    exit_with_error(ERROR_SOCKET_CREATION, "Socket failed");
+ }
+ int one = 1;
+ setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+ struct sockaddr_in addr;
+ memset(&addr, 0, sizeof(addr));
+ addr.sin_family = AF_INET;
+ addr.sin_port = htons((uint16_t)port);
+ addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+ if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0 || listen(fd, 1) != 0) {
+    exit_with_error(ERROR_SOCKET_CREATION, "Bind/listen failed");
+ }
+ return fd;
+}
+
+int server_accept(const int listen_fd)
+{
+ int fd = accept(listen_fd, NULL, NULL);
+ if (fd < 0) return RETURN_ERROR;
+ int one = 1;
+ setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+ return fd;
+}
+
+/*
+Server`s KDF. Client hashes (shared secret, their PK, your PK), so from
+the server side the order is (shared secret, own PK, client`s PK).
+*/
+static void server_kdf(uint8_t *shared_key, const uint8_t *server_sk, const uint8_t *server_pk, const uint8_t *client_pk)
+{
+ uint8_t shared_secret[KEYSZ];
+ crypto_x25519(shared_secret, server_sk, client_pk);
+
+ crypto_blake2b_ctx ctx;
+ crypto_blake2b_init(&ctx, KEYSZ);
+ crypto_blake2b_update(&ctx, shared_secret, KEYSZ);
+ crypto_blake2b_update(&ctx, server_pk, KEYSZ);
+ crypto_blake2b_update(&ctx, client_pk, KEYSZ);
+ crypto_blake2b_final(&ctx, shared_key);
+
+ crypto_wipe(shared_secret, KEYSZ);
+}
+
+//////////////////////////////////////////
+/// Server side of key_exc_ell() ///
+//////////////////////////////////////////
+void server_handshake(const int fd, const uint8_t *plain_key, uint8_t *writing_key, uint8_t *reading_key)
+{
+ uint8_t client_pk[KEYSZ];
+ uint8_t server_sk[KEYSZ];
+ uint8_t server_pk[KEYSZ];
+ uint8_t hidden[KEYSZ];
+ uint8_t mac_us[MACSZ];
+ uint8_t mac_thm[MACSZ];
+ const int pad_size_key = PADME_SIZE(KEYSZ);
+ const int pad_size_mac = PADME_SIZE(MACSZ);
+ uint8_t pad_key[PADME_SIZE(KEYSZ)];
+ uint8_t pad_mac[PADME_SIZE(MACSZ)];
+
+ /*Client`s hidden PK*/
+ server_read_or_exit(fd, pad_key, pad_size_key);
+ unpad_array(hidden, pad_key, KEYSZ);
+ crypto_elligator_map(client_pk, hidden);
+
+ /*First server key pair -> our reading key(client`s writing key)*/
+ key_hidden(server_sk, server_pk, hidden, KEYSZ);
+ pad_array(hidden, pad_key, KEYSZ, pad_size_key);
+ server_write_or_exit(fd, pad_key, pad_size_key);
+ server_kdf(reading_key, server_sk, server_pk, client_pk);
+
+ /*MAC of first key proves we own long-term key*/
+ crypto_blake2b_keyed(mac_us, MACSZ, plain_key, KEYSZ, reading_key, KEYSZ);
+ pad_array(mac_us, pad_mac, MACSZ, pad_size_mac);
+ server_write_or_exit(fd, pad_mac, pad_size_mac);
+
+ /*Second server key pair -> our writing key(client`s reading key)*/
+ key_hidden(server_sk, server_pk, hidden, KEYSZ);
+ pad_array(hidden, pad_key, KEYSZ, pad_size_key);
+ server_write_or_exit(fd, pad_key, pad_size_key);
+ server_kdf(writing_key, server_sk, server_pk, client_pk);
+ crypto_wipe(server_sk, KEYSZ);
+
+ /*Client proves it owns long-term key(and knows PIN)*/
+ crypto_blake2b_keyed(mac_us, MACSZ, plain_key, KEYSZ, writing_key, KEYSZ);
+ server_read_or_exit(fd, pad_mac, pad_size_mac);
+ unpad_array(mac_thm, pad_mac, MACSZ);
+ if (crypto_verify16(mac_us, mac_thm) != OK) {
+    exit_with_error(UNEQUAL_MAC, "Other side isn`t legit, aborting");
+ }
+}
+//////////////////////////////////////////
+//////////////////////////////////////////
+
+//////////////////////////////////////////
+/// Server side of chat() ///
+//////////////////////////////////////////
+/*
+Traffic of all sessions of server_chat(), read by server_traffic_get().
+*/
+static struct server_traffic traffic = {0};
+
+/*
+Counts one frame with compressed text of `size` bytes sent as a padded
+message of `padded_size` bytes(same sizes without MESSAGE_PADDING).
+*/
+static void server_count_traffic(const int pad_size_mac, const uint32_t size, const uint32_t padded_size)
+{
+ traffic.frames++;
+ traffic.wire += (uint64_t)pad_size_mac + BYTE_ARRAY_SZ + padded_size;
+ traffic.unpadded += (uint64_t)pad_size_mac + BYTE_ARRAY_SZ + size;
+}
+
+void server_traffic_get(struct server_traffic *out)
+{
+ *out = traffic;
+}
+
+int server_chat(const int fd, uint8_t *writing_key, uint8_t *reading_key)
+{
+ uint8_t buff[MESSAGE_MAX];
+ uint8_t compr[MESSAGE_MAX];
+ uint8_t plain[BUFF_MAX];
+ uint8_t size_bytes[BYTE_ARRAY_SZ];
+ uint32_t size = 0;
+ uint32_t padded_size = 0;
+ uint8_t nonce_us[NONSZ];
+ uint8_t nonce_thm[NONSZ];
+ uint8_t mac[MACSZ];
+ const int pad_size_nonce = PADME_SIZE(NONSZ);
+ const int pad_size_mac = PADME_SIZE(MACSZ);
+ uint8_t pad_nonce[PADME_SIZE(NONSZ)];
+ uint8_t pad_mac[PADME_SIZE(MACSZ)];
+ crypto_aead_ctx ctx_us;
+ crypto_aead_ctx ctx_thm;
+ struct compress_ctx compr_ctx;
+ int count = 0;
+
+ /*Client sends nonce first, then reads ours*/
+ random_num(nonce_us, NONSZ);
+ server_read_or_exit(fd, pad_nonce, pad_size_nonce);
+ unpad_array(nonce_thm, pad_nonce, NONSZ);
+ pad_array(nonce_us, pad_nonce, NONSZ, pad_size_nonce);
+ server_write_or_exit(fd, pad_nonce, pad_size_nonce);
+
+ crypto_aead_init_x(&ctx_us, writing_key, nonce_us);
+ crypto_aead_init_x(&ctx_thm, reading_key, nonce_thm);
+ crypto_wipe(writing_key, KEYSZ);
+ crypto_wipe(reading_key, KEYSZ);
+ compress_init(&compr_ctx);
+
+ while (1) {
+    /*Padded MAC, size and encrypted message of the client*/
+    if (server_read(fd, pad_mac, pad_size_mac) != OK) break;
+    unpad_array(mac, pad_mac, MACSZ);
+    if (server_read(fd, size_bytes, BYTE_ARRAY_SZ) != OK) break;
+    padded_size = from_byte_array(size_bytes, 0);
+    if (padded_size > MESSAGE_MAX) {
+       exit_with_error(TEXT_OVERFLOW, "Received message is bigger than buffer");
+    }
+    if (server_read(fd, buff, padded_size) != OK) break;
+
+    if (crypto_aead_read(&ctx_thm, compr, mac, NULL, 0, buff, padded_size) != OK) {
+       exit_with_error(MESSAGE_ALTERED, "Last received message was altered, exiting");
+    }
+    if (unpad_message(compr, padded_size, &size) != OK) {
+       exit_with_error(TEXT_OVERFLOW, "Received message has wrong padding");
+    }
+    server_count_traffic(pad_size_mac, size, padded_size);
+    memset(plain, 0, BUFF_MAX);
+    decompress_text(&compr_ctx, compr + MESSAGE_OFFSET, TEXT_MAX, plain, size);
+
+    /*Client ends after sending the stop-word, no reply is expected*/
+    if (strncmp((const char *)plain, EXIT, strlen(EXIT)) == OK) break;
+
+    /*Echo the message back*/
+    compress_text(&compr_ctx, plain, BUFF_MAX, compr + MESSAGE_OFFSET, &size);
+    padded_size = pad_message(compr, size);
+    crypto_aead_write(&ctx_us, buff, mac, NULL, 0, compr, padded_size);
+    pad_array(mac, pad_mac, MACSZ, pad_size_mac);
+    to_byte_array(padded_size, size_bytes);
+    if (server_write(fd, pad_mac, pad_size_mac) != OK ||
+        server_write(fd, size_bytes, BYTE_ARRAY_SZ) != OK ||
+        server_write(fd, buff, padded_size) != OK) break;
+    server_count_traffic(pad_size_mac, size, padded_size);
+    count++;
+ }
+
+ compress_free(&compr_ctx);
+ crypto_wipe(&ctx_us, sizeof(ctx_us));
+ crypto_wipe(&ctx_thm, sizeof(ctx_thm));
+ crypto_wipe(plain, BUFF_MAX);
+ return count;
+}
+//////////////////////////////////////////
+//////////////////////////////////////////
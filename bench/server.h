@@ -0,0 +1,82 @@
+// Client-server API(PICO)        //
+// Reference server               //
+// Version 0.9.1pi                //
+// Bachelor's Work Project        //
+// Technical University of Kosice //
+// 17.10.2026                     //
+// Nikita Kuropatkin              //
+// Host tools for                 //
+// W5100S-EVB-Pico                //
+
+/*
+This header file declares functions of the reference server for the
+Linux host build. The server speaks exactly the wire protocol of
+key_exc_ell() and chat() from client.c (padded Elligator keys, padded
+MACs, 4-byte Big Endian sizes and AEAD frames) over BSD sockets.
+Function bodies are in server.c.
+*/
+#ifndef SERVER_H
+#define SERVER_H
+#include <stdint.h>
+
+/*
+In use: server.c, bench_chat.c.
+PIN that protects the long-term key written to the client`s flash image.
+*/
+#define SERVER_PIN "777777"
+
+/*
+Creates the client`s flash image at `flash_path`: generates long-term key
+and salt, secures the key by SERVER_PIN with Argon2i (same parameters as
+pin.c) and stores key and salt to FLASH_PAGE, like `flash_key_salt` does
+on the board. Plain long-term key is written to `plain_key`.
+*/
+void server_provision(const char *flash_path, uint8_t *plain_key);
+
+/*
+Opens listening TCP socket on loopback `port`. Returns file descriptor.
+*/
+int server_listen(const int port);
+
+/*
+Accepts one client on `listen_fd` with TCP_NODELAY(like the client`s socket).
+Returns file descriptor of the connection or RETURN_ERROR.
+*/
+int server_accept(const int listen_fd);
+
+/*
+Server side of key_exc_ell(): derives `writing_key` (client`s reading key)
+and `reading_key` (client`s writing key), authenticates both sides with
+MACs keyed by `plain_key`. Exits with an error if client is not legit.
+*/
+void server_handshake(const int fd, const uint8_t *plain_key, uint8_t *writing_key, uint8_t *reading_key);
+
+/*
+Server side of chat(): exchanges nonces, then echoes every received
+message back to the client until the stop-word or end of connection.
+Returns amount of echoed messages.
+*/
+int server_chat(const int fd, uint8_t *writing_key, uint8_t *reading_key);
+
+/*
+Frames of chat() counted by server_chat() in both directions since the
+start of the program: bytes on the wire(padded MAC, size and encrypted
+text) and the same bytes without padding of messages(MESSAGE_PADDING).
+*/
+struct server_traffic {
+ uint64_t frames;   // Amount of frames
+ uint64_t wire;     // Bytes sent and received
+ uint64_t unpadded; // Bytes of the same frames without PADME of messages
+};
+
+/*
+Copies counters of the chat traffic to `out`.
+*/
+void server_traffic_get(struct server_traffic *out);
+
+/*
+Returns monotonic time in microseconds.
+*/
+uint64_t server_now_us(void);
+
+#endif
@@ -0,0 +1,56 @@
+// Client-server API(PICO)        //
+// Reference server               //
+// Version 0.9.1pi                //
+// Bachelor's Work Project        //
+// Technical University of Kosice //
+// 17.10.2026                     //
+// Nikita Kuropatkin              //
+// Host tools for                 //
+// W5100S-EVB-Pico                //
+
+/*
+Standalone reference server for the Linux host build of the client.
+Usage: client_pico_server [port] [flash image]
+The server provisions the flash image (key secured by PIN 777777 + salt),
+so it must be started first, then the client is started with
+CLIENT_PICO_FLASH pointing to the same image.
+Every received message is echoed back to the client.
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include "server.h"
+#include "random.h"
+#include "parameters.h"
+
+int main(int argc, char **argv)
+{
+ int port = (argc > 1) ? atoi(argv[1]) : PORT;
+ const char *flash_path = (argc > 2) ? argv[2] : HOST_FLASH_FILE;
+ uint8_t plain_key[KEYSZ];
+
+ random_init();
+ server_provision(flash_path, plain_key);
+ printf("Flash image %s provisioned (PIN %s)\n", flash_path, SERVER_PIN);
+
+ int listen_fd = server_listen(port);
+ printf("Listening on 127.0.0.1:%d\n", port);
+
+ while (1) {
+    uint8_t writing_key[KEYSZ];
+    uint8_t reading_key[KEYSZ];
+    int fd = server_accept(listen_fd);
+    if (fd < 0) continue;
+
+    uint64_t start = server_now_us();
+    server_handshake(fd, plain_key, writing_key, reading_key);
+    uint64_t handshake = server_now_us() - start;
+
+    int count = server_chat(fd, writing_key, reading_key);
+    printf("Session: handshake %llu us, %d messages echoed\n",
+           (unsigned long long)handshake, count);
+    close(fd);
+ }
+ return 0;
+}
@@ -52,6 +52,32 @@ AEAD - authenticated encryption with additional data
 
 //////////Version history//////////
 /*
+Version 0.9.1pi (17.10.2026):
+# Added Linux host build with emulated W5100S/flash/watchdog (src/host)
+# Added reference server and end-to-end chat benchmark (bench/)
+# Added cycle benchmark of used Monocypher primitives (bench_crypto)
+# Added phase tracing into a ring buffer with CSV dump (trace.c)
+# read_pico()/write_pico() move exactly `size` bytes with NET_TIMEOUT
+# Chat message is sent as one frame(MAC, size, text), header read at once
+# Received text is decrypted in AEAD_CHUNK pieces, buffer `compr` removed
+# Added full-duplex chat mode(CHAT_MODE DUPLEX) polling stdin and socket
+# Transport errors reconnect to the server instead of reboot(error.h)
+# Sessions run forever on one chip/XDRBG init, LIVE_COUNT reboot removed
+# Core1 precomputes Elligator keypairs into a pool(keypool.c)
+# PIN is asked before connect, Argon2i runs on core1 during handshake
+# Argon2i lanes are filled by both cores when LANSES > 1(argon2_lanes.c)
+# Added Argon2i calibration("calibrate"), parameters are stored after salt
+# Added masked cache of the unlocked key with idle timeout(KEY_CACHE_TIMEOUT)
+# Small random requests are served from a pool of XDRBG output(RANDOM_POOL)
+# Added 32-bit bit-interleaved Keccak-f[1600] for XDRBG(keccak_bi.c)
+# PADME for any size with CLZ and PADME_SIZE/PADME_ROUND macros, no math.h
+# Messages in chat are PADME padded inside of AEAD(MESSAGE_PADDING, opt-in)
+# LZRW3-A work memory is taken once per chat() session(struct compress_ctx)
+# Streaming compression with history of the session(COMPRESS_STREAM, opt-in)
+# One byte header of compressed messages, short texts are stored(COMPRESS_MIN)
+# Compressor backends, added LZSS with 1 KB window(lzss.c, COMPRESS_BACKEND)
+# LZRW3-A with 16-bit offsets in a table sized for the longest block(LZRW3A16)
+# Dictionary in flash primes LZRW3-A for short messages(COMPRESS_DICT opt-in, dict_build)
 Version 0.9.0pi (23.02.2025):  
 # Added new .h and .c files: network_data
 # Added 3 ways of configuration of netdata: DHCP, Last used, Manual
@@ -168,6 +194,7 @@ Version 0.1(11.09.2024) - basic functionality
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
+#include <setjmp.h>
 #include "monocypher.h"
 #include "network.h"
 #include "addition.h"
@@ -177,6 +204,9 @@ Version 0.1(11.09.2024) - basic functionality
 #include "error.h"
 #include "client/pin.h"
 #include "compress_decompress.h"
+#include "trace.h"
+#include "keypool.h"
+#include "core1.h"
 
 /*Wiznet depencies*/
 #include "timing.h"
@@ -198,6 +228,7 @@ Also input variables are port number and server IP
 */
 static int sockct_opn(int port, uint8_t *ip)
 {
+ TRACE_BEGIN(trace_begin);
  // Create a TCP socket on the specified port with no-delay option
  uint32_t retval = socket(SOCKET_NUM, Sn_MR_TCP, port, SF_TCP_NODELAY);
  if (retval != SOCKET_NUM) {
@@ -222,6 +253,7 @@ static int sockct_opn(int port, uint8_t *ip)
     exit_with_error(ERROR_CLIENT_CONNECTION, "Connect failed");
  }
 
+ TRACE_END(TRACE_CONNECT, trace_begin, port);
  // Return the socket number on successful connection
  return SOCKET_NUM;
 }
@@ -229,34 +261,277 @@ static int sockct_opn(int port, uint8_t *ip)
 ///////////////////////////////////////////////////
 ///////////////////////////////////////////////////
 
+///////////////////////////////////////////////////
+/// Receiving of encrypted text in chunks ///
+///////////////////////////////////////////////////
+/*
+This function receives `size` bytes of encrypted text in pieces of 
+AEAD_CHUNK bytes and every piece is authenticated and decrypted straight
+into `text`, so the encrypted text is never stored as a whole message.
+Result is the same as read_pico() + crypto_aead_read(), but without
+one BUFF_MAX buffer and one copy of the message.
+Returns OK, or RETURN_ERROR if the message was altered(`text` is wiped).
+*/
+static int read_decrypt(int sockfd, crypto_aead_ctx *ctx, const uint8_t *mac, uint8_t *text, const uint32_t size)
+{
+ struct aead_stream stream; // State of the message being decrypted
+ uint8_t chunk[AEAD_CHUNK]; // Piece of encrypted text from the socket
+
+ aead_read_init(&stream, ctx);
+ for (uint32_t done = 0; done < size; done += AEAD_CHUNK) {
+    uint32_t chunk_size = (size - done < AEAD_CHUNK) ? size - done : AEAD_CHUNK;
+    read_pico(sockfd, chunk, chunk_size);
+    aead_read_update(&stream, ctx, text + done, chunk, chunk_size);
+ }
+ crypto_wipe(chunk, AEAD_CHUNK);
+
+ if (aead_read_final(&stream, ctx, mac) != OK) {
+    crypto_wipe(text, size); // Never leave unauthenticated text
+    return RETURN_ERROR;
+ }
+ return OK;
+}
+///////////////////////////////////////////////////
+///////////////////////////////////////////////////
+
+///////////////////////////////////////////////////
+/// Sending and receiving of one message ///
+///////////////////////////////////////////////////
+/*
+This function compresses, encrypts and sends one message `plain`.
+Frame of the message: padded MAC || size(4 bytes) || encrypted text,
+with MESSAGE_PADDING the encrypted text is the padded message
+(size of compressed text || compressed text || zeros, pad_message()).
+The whole frame is assembled in `frame`(header + MESSAGE_MAX bytes) and 
+sent by one send(), so it is one SEND command of W5100S and usually one 
+TCP segment. Text is compressed into the frame and encrypted in place,
+so there is no other buffer for compressed or encrypted text.
+*/
+static void send_message(int sockfd, crypto_aead_ctx *ctx, struct compress_ctx *compr, uint8_t *frame, const int pad_size_mac, char *plain)
+{
+ int header_size = pad_size_mac + BYTE_ARRAY_SZ; // Size of frame header
+ uint8_t *frame_text = frame + header_size; // Encrypted text of the frame
+ uint8_t mac[MACSZ]; // MAC of our message
+ uint32_t compr_size = 0; // Size of compressed text
+ uint32_t padded_size = 0; // Size of padded message(encrypted text)
+
+ // Compressing inputed text straight into the frame
+ compress_text(compr, (uint8_t*)plain, BUFF_MAX, frame_text + MESSAGE_OFFSET, &compr_size); 
+
+ /*Size prefix and PADME padding of the compressed text(MESSAGE_PADDING)*/
+ padded_size = pad_message(frame_text, compr_size);
+
+ // Encrypt padded message in place and generate MAC for it
+ TRACE_BEGIN(trace_write);
+ crypto_aead_write(ctx, frame_text, mac, NULL, 0, frame_text, padded_size);
+ TRACE_END(TRACE_AEAD_WRITE, trace_write, padded_size);
+
+ /*Padding our MAC into the frame header*/
+ pad_array(mac, frame, MACSZ, pad_size_mac);
+
+ // Convert size to byte array(frame header)
+ to_byte_array(padded_size, frame + pad_size_mac);
+
+ // Send padded MAC, size and encrypted message to server at once
+ write_pico(sockfd, frame, header_size + padded_size);
+
+ memset(frame, 0, header_size + padded_size); // Clear frame
+}
+
+/*
+This function receives one message into `plain`(TEXT_MAX bytes).
+The padded MAC and size(frame header) are read at once, encrypted text is
+decrypted in chunks into `frame`(read_decrypt()) and decompressed.
+The program exits if the message was altered or is too big.
+*/
+static void receive_message(int sockfd, crypto_aead_ctx *ctx, struct compress_ctx *compr, uint8_t *frame, const int pad_size_mac, char *plain)
+{
+ int header_size = pad_size_mac + BYTE_ARRAY_SZ; // Size of frame header
+ uint8_t *frame_text = frame + header_size; // Encrypted text of the frame
+ uint8_t mac[MACSZ]; // MAC of their message
+ uint32_t compr_size = 0; // Size of compressed text
+ uint32_t padded_size = 0; // Size of padded message(encrypted text)
+
+ // Get padded MAC and size of message(frame header) at once
+ read_pico(sockfd, frame, header_size);
+ /*Un-pad recieved MAC*/
+ unpad_array(mac, frame, MACSZ);
+
+ // Convert size to uint32_t
+ padded_size = from_byte_array(frame + pad_size_mac, padded_size);
+ /*Size from the other side must fit the buffers*/
+ if (padded_size > MESSAGE_MAX) {
+     exit_with_error(TEXT_OVERFLOW, "Received message is bigger than buffer");
+ }
+
+ // Get, decrypt and authenticate the message from the server
+ TRACE_BEGIN(trace_read);
+ if (read_decrypt(sockfd, ctx, mac, frame_text, padded_size) != OK) 
+ {
+     /* If the message was altered during transmission*/
+     exit_with_error(MESSAGE_ALTERED, "Last received message was altered, exiting"); 
+ }
+ TRACE_END(TRACE_AEAD_READ, trace_read, padded_size);
+
+ /*Size of the compressed text inside of the padded message*/
+ if (unpad_message(frame_text, padded_size, &compr_size) != OK) {
+     exit_with_error(TEXT_OVERFLOW, "Received message has wrong padding");
+ }
+
+ // Decompress unencrypted text
+ memset(plain, 0, TEXT_MAX);
+ decompress_text(compr, frame_text + MESSAGE_OFFSET, TEXT_MAX, (uint8_t*)plain, compr_size);
+ memset(frame, 0, header_size + padded_size); // Clear frame
+
+ /* 
+  Inserting terminator at the actual end 
+  of string to avoid showing another garbage
+ */
+ for (int j = 0; j < TEXT_MAX; j++) {
+     if(plain[j] == '\n' && j != TEXT_MAX-1) plain[j+1] = '\0';
+ }
+}
+///////////////////////////////////////////////////
+///////////////////////////////////////////////////
+
+///////////////////////////////////////////////////
+/// Chat loops(turns and full-duplex) ///
+///////////////////////////////////////////////////
+/*
+Strict ping-pong chat: the user writes one message, then the client 
+waits for exactly one reply from the server.
+*/
+static void chat_turns(crypto_aead_ctx *ctx_us, crypto_aead_ctx *ctx_thm, struct compress_ctx *compr, int sockfd, uint8_t *frame, const int pad_size_mac)
+{
+ char plain[TEXT_MAX]; // Buffer for decrypted(plain) text
+
+ // Chat loop:
+ while (1) {
+    // Clear vars 
+    memset(plain, 0, TEXT_MAX);
+
+    // Recieve message to send
+    printf("To server: ");
+    if (fgets(plain, TEXT_MAX, stdin) == NULL) {
+        exit_with_error(ERROR_GETTING_INPUT, "Error reading input");
+    }
+    // Buffer overflow, clear stdin
+    if (plain[strlen(plain) - 1] != '\n') {
+        printf("\nYour message was too long, boundaries is: %d symbols,"
+               "only those will be sent.\n",TEXT_MAX);
+        clear();
+        plain[strlen(plain) - 1] = '\n';
+    }
+
+    send_message(sockfd, ctx_us, compr, frame, pad_size_mac, plain);
+
+    if (exiting("Client", plain) == YES) break; //Checks for stop-word
+		
+    crypto_wipe(plain, TEXT_MAX);// clear plain
+
+    receive_message(sockfd, ctx_thm, compr, frame, pad_size_mac, plain);
+    printf("    From server: %s", plain);
+
+    if (exiting("Server", plain) == YES) break; //Checks for stop-word
+
+    crypto_wipe(plain, TEXT_MAX); //Clear plain
+ }
+ crypto_wipe(plain, TEXT_MAX);
+}
+
+/*
+Full-duplex chat: one loop polls stdin(getchar_timeout_us()) and 
+the received size register of the socket(getSn_RX_RSR()).
+Each direction has its own AEAD state and its own buffer:
+the line being typed(sent as soon as Enter is pressed) and 
+the received message(processed as soon as its header is in RX memory),
+so a burst of messages from either side does not wait for the other one.
+*/
+static void chat_duplex(crypto_aead_ctx *ctx_us, crypto_aead_ctx *ctx_thm, struct compress_ctx *compr, int sockfd, uint8_t *frame, const int pad_size_mac)
+{
+ char line[TEXT_MAX]; // Line the user is typing(outgoing)
+ char plain[TEXT_MAX]; // Last received message(incoming)
+ int line_len = 0; // Amount of typed characters in `line`
+ int skip_rest = NO; // Too long line was sent, skip it until Enter
+ int ended = NO; // One of the sides wrote the stop-word
+ int header_size = pad_size_mac + BYTE_ARRAY_SZ; // Size of frame header
+ int c; // Typed character
+
+ memset(line, 0, TEXT_MAX);
+ printf("To server: ");
+
+ while (ended == NO) {
+    /*Outgoing: take typed characters, send the line on Enter*/
+    while ((c = getchar_timeout_us(0)) != PICO_ERROR_TIMEOUT) {
+       if (c < 0) {
+          exit_with_error(ERROR_GETTING_INPUT, "Error reading input");
+       }
+       if (skip_rest == YES) {
+          if (c == '\n') skip_rest = NO;
+          continue;
+       }
+       line[line_len++] = (char)c;
+
+       // Buffer overflow, rest of the line is skipped
+       if (c != '\n' && line_len == TEXT_MAX - 1) {
+          printf("\nYour message was too long, boundaries is: %d symbols,"
+                 "only those will be sent.\n",TEXT_MAX);
+          line[line_len - 1] = '\n';
+          skip_rest = YES;
+          c = '\n';
+       }
+       if (c == '\n') {
+          send_message(sockfd, ctx_us, compr, frame, pad_size_mac, line);
+          ended = exiting("Client", line); //Checks for stop-word
+          crypto_wipe(line, TEXT_MAX);
+          line_len = 0;
+          if (ended == NO) printf("To server: ");
+          break; // One message per round, then look at the socket
+       }
+    }
+    if (ended == YES) break;
+
+    /*Incoming: whole header of the next frame is in RX memory*/
+    uint16_t received = getSn_RX_RSR(sockfd);
+    if (received >= header_size) {
+       receive_message(sockfd, ctx_thm, compr, frame, pad_size_mac, plain);
+       printf("\n    From server: %s", plain);
+       ended = exiting("Server", plain); //Checks for stop-word
+       crypto_wipe(plain, TEXT_MAX);
+       if (ended == NO) printf("To server: %.*s", line_len, line); // Typed text
+    }
+    else if (received == 0 && getSn_SR(sockfd) != SOCK_ESTABLISHED) {
+       exit_with_error(ERROR_RECEIVING_DATA, "Connection closed by server");
+    }
+ }
+ crypto_wipe(line, TEXT_MAX);
+ crypto_wipe(plain, TEXT_MAX);
+}
+///////////////////////////////////////////////////
+///////////////////////////////////////////////////
+
 ///////////////////////////////////////////////////
 /// Client-server communication "chatting" ///
 ///////////////////////////////////////////////////
 static void chat(uint8_t* writing_key, uint8_t* reading_key, int sockfd)
 {
- // Variables for text(plain, compressed, encrypted)
- char buff[BUFF_MAX]; // Buffer for encrypted text
- char plain[TEXT_MAX]; // Buffer for decrypted(plain) text
- char compr[BUFF_MAX]; // Buffer for compressed text
- uint32_t compr_size = 0; // Size of compressed text
- /*Also size of compressed text in uint8_t array(needed for sending)*/
- uint8_t compr_size_bytes[BYTE_ARRAY_SZ];
-    
  // Variables for nonce
  uint8_t nonce_us[NONSZ]; // Our nonce array
  uint8_t nonce_thm[NONSZ]; // Their nonce array
- int pad_size_nonce = padme_size(NONSZ); // Size of padded nonce
+ const int pad_size_nonce = PADME_SIZE(NONSZ); // Size of padded nonce
  /*New array that will contain padded nonce*/
- uint8_t pad_nonce[pad_size_nonce]; // Size of padded Nonce
+ uint8_t pad_nonce[PADME_SIZE(NONSZ)]; // Size of padded Nonce
  /*New array that will contain their padded nonce*/
- uint8_t pad_nonce_their[pad_size_nonce]; 
+ uint8_t pad_nonce_their[PADME_SIZE(NONSZ)]; 
 
  // Variables for MAC
- uint8_t mac_us[MACSZ]; // MAC of our messages
- uint8_t mac_thm[MACSZ]; // MAC of their messages
- int pad_size_mac = padme_size(MACSZ); // Size of padded MAC
- uint8_t padded_mac_us[pad_size_mac]; // Our padded MAC
- uint8_t padded_mac_thm[pad_size_mac]; // Their padded MAC
+ const int pad_size_mac = PADME_SIZE(MACSZ); // Size of padded MAC
+
+ /*
+ Frame of one message(padded MAC, size and encrypted text), 
+ shared by both directions, see send_message() and receive_message().
+ */
+ uint8_t frame[PADME_SIZE(MACSZ) + BYTE_ARRAY_SZ + MESSAGE_MAX];
 
  /*AEAD state variables:*/
  /*
@@ -270,6 +545,13 @@ static void chat(uint8_t* writing_key, uint8_t* reading_key, int sockfd)
  */
  crypto_aead_ctx ctx_thm;
 
+ /*
+ Compression context for the whole session: work memory of the 
+ backend(COMPRESS_BACKEND), taken once. Each direction has its own
+ table and, with COMPRESS_STREAM, its own history.
+ */
+ struct compress_ctx compr;
+
  // Generate nonce
  random_num(nonce_us, NONSZ);
 
@@ -295,92 +577,23 @@ static void chat(uint8_t* writing_key, uint8_t* reading_key, int sockfd)
  crypto_wipe(reading_key, KEYSZ); // Wiping original reading SK
  crypto_wipe(writing_key, KEYSZ); // Wiping original writing SK
 
- // Chat loop:
- while (1) {
-    // Clear vars 
-    memset(buff, 0, BUFF_MAX);
-    memset(plain, 0, TEXT_MAX);
-    memset(compr, 0, BUFF_MAX);
-    memset(compr_size_bytes, 0, BYTE_ARRAY_SZ);
-    compr_size = 0;
-
-    // Recieve message to send
-    printf("To server: ");
-    if (fgets(plain, TEXT_MAX, stdin) == NULL) {
-        exit_with_error(ERROR_GETTING_INPUT, "Error reading input");
-    }
-    // Buffer overflow, clear stdin
-    if (plain[strlen(plain) - 1] != '\n') {
-        printf("\nYour message was too long, boundaries is: %d symbols,"
-               "only those will be sent.\n",TEXT_MAX);
-        clear();
-        plain[strlen(plain) - 1] = '\n';
-    }
-
-    // Compressing inputed text
-    compress_text((uint8_t*)plain, BUFF_MAX, (uint8_t*)compr, &compr_size); 
-
-    // Encrypt compressed message and generate MAC for it
-    crypto_aead_write(&ctx_us, (uint8_t*)buff, mac_us, NULL, 0,(uint8_t*)compr, compr_size);
-
-    /*Padding our MAC*/
-    pad_array(mac_us, padded_mac_us, MACSZ, pad_size_mac);
-    /*Send padded MAC of our message*/
-    write_pico(sockfd, padded_mac_us, pad_size_mac);
-
-    // Convert size to byte array
-    to_byte_array(compr_size,compr_size_bytes);
-    // Send size of message to other side
-    write_pico(sockfd, compr_size_bytes, BYTE_ARRAY_SZ);
-    // Send encrypted message to server
-    write_pico(sockfd, (uint8_t*)buff, compr_size);
-
-    if (exiting("Client", plain) == YES) break; //Checks for stop-word
-		
-    // Clear buffers 
-    memset(buff, 0, BUFF_MAX);
-    memset(compr, 0, BUFF_MAX);
-    crypto_wipe(plain, TEXT_MAX);// clear plain
-    memset(compr_size_bytes, 0, BYTE_ARRAY_SZ);
-    compr_size = 0;
-
-    // Get padded MAC of message
-    read_pico(sockfd, padded_mac_thm, pad_size_mac);
-    /*Un-pad recieved MAC*/
-    unpad_array(mac_thm, padded_mac_thm, MACSZ);
-
-    // Get size of message from other side
-    read_pico(sockfd, compr_size_bytes, BYTE_ARRAY_SZ);
-    // Convert to uint32_t
-    compr_size = from_byte_array( compr_size_bytes, compr_size);
-    // Get message from other side
-    read_pico(sockfd, (uint8_t*)buff, compr_size);
-
-    // Decrypt and authenticate the message from the server
-    if (crypto_aead_read(&ctx_thm, (uint8_t*)compr, mac_thm, NULL, 0,(uint8_t*)buff, compr_size) != OK) 
-    {
-        /* If the message was altered during transmission*/
-        exit_with_error(MESSAGE_ALTERED, "Last received message was altered, exiting"); 
-    }
-
-    // Decompress unencrypted text
-    decompress_text((uint8_t*)compr, BUFF_MAX, (uint8_t*)plain, compr_size);
-
-    /* 
-     Inserting terminator at the actual end 
-     of string to avoid showing another garbage
-    */
-    for (int j = 0; j < TEXT_MAX; j++) {
-        if(plain[j] == '\n' && j != TEXT_MAX-1) plain[j+1] = '\0';
-    }
-    printf("    From server: %s", plain);
-
-    if (exiting("Server", plain) == YES) break; //Checks for stop-word
-
-    crypto_wipe(plain, TEXT_MAX); //Clear plain
+ memset(frame, 0, sizeof(frame));
+ /*
+  History of the compression starts with the AEAD session, a new key 
+  exchange resets it on both sides(COMPRESS_STREAM in parameters.h)
+ */
+ compress_init(&compr);
 
-    }
+ /*Chat mode is chosen by CHAT_MODE macro(parameters.h)*/
+ #if CHAT_MODE == DUPLEX
+   chat_duplex(&ctx_us, &ctx_thm, &compr, sockfd, frame, pad_size_mac);
+ #else
+   chat_turns(&ctx_us, &ctx_thm, &compr, sockfd, frame, pad_size_mac);
+ #endif
 
+ compress_free(&compr);
+ crypto_wipe(&ctx_us, sizeof(ctx_us));
+ crypto_wipe(&ctx_thm, sizeof(ctx_thm));
 }
 ///////////////////////////////////////////////////
 ///////////////////////////////////////////////////
@@ -408,21 +621,21 @@ static void key_exc_ell(int sockfd)
  uint8_t mac_us[MACSZ]; 
  /*Keyed MAC of shared key(server), authentication of other side*/
  uint8_t mac_thm[MACSZ]; 
- int pad_size_mac = padme_size(MACSZ);
- uint8_t padded_mac_us[pad_size_mac]; //our padded MAC
- uint8_t padded_mac_thm[pad_size_mac]; //their padded MAC
+ const int pad_size_mac = PADME_SIZE(MACSZ);
+ uint8_t padded_mac_us[PADME_SIZE(MACSZ)]; //our padded MAC
+ uint8_t padded_mac_thm[PADME_SIZE(MACSZ)]; //their padded MAC
  
  /*Computing size of padded hidden PK and creating variable*/
- int pad_size_key = padme_size(KEYSZ);
- uint8_t pad_your_pk[pad_size_key]; //our padded hidden PK
- uint8_t pad_hidden[pad_size_key]; //their padded hidden PK
+ const int pad_size_key = PADME_SIZE(KEYSZ);
+ uint8_t pad_your_pk[PADME_SIZE(KEYSZ)]; //our padded hidden PK
+ uint8_t pad_hidden[PADME_SIZE(KEYSZ)]; //their padded hidden PK
  
  /*
  Generating first shared secret - our writing key, their reading key
  */
  
- /*Generate SK and hidden PK*/
- key_hidden(your_sk, your_pk, your_hidden, KEYSZ);
+ /*Take SK and hidden PK precomputed by core1(keypool.c)*/
+ keypool_take(your_sk, your_pk, your_hidden);
  
  // Padding of hidden PK
  pad_array(your_hidden, pad_your_pk, KEYSZ, pad_size_key);
@@ -443,8 +656,8 @@ static void key_exc_ell(int sockfd)
  // Compute our writing key(their reading key)
  kdf(writing_key, your_sk, your_pk, their_first_pk, KEYSZ);
  
- // Asking and checking PIN for SK from user
- pin_checker(plain_key);
+ // Key unlocked by PIN on core1 while connecting(pin_unlock_start())
+ pin_unlock_wait(plain_key);
  
  // Compute keyed MAC of our writing key
  crypto_blake2b_keyed(mac_us, MACSZ, plain_key, KEYSZ, writing_key, KEYSZ);
@@ -492,6 +705,29 @@ static void key_exc_ell(int sockfd)
 //////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////
 
+////////////////////////////////
+/// Stack wiping ///
+////////////////////////////////
+/*
+After a transport error the program returns to main() by longjmp, 
+so the frames of key_exc_ell() and chat() with keys, AEAD states and
+plain text are not wiped by them. This function overwrites the stack 
+below main() with zeros. With STATIC_STACK allocation the frame of 
+chat() also holds the work memory of the compressor(struct compress_ctx).
+*/
+#if ALLOCATION == STATIC_STACK
+  #define STACK_WIPE_AREA (STACK_WIPE_SIZE + sizeof(struct compress_ctx))
+#else
+  #define STACK_WIPE_AREA STACK_WIPE_SIZE
+#endif
+static void __attribute__((noinline)) wipe_stack(void)
+{
+ uint8_t area[STACK_WIPE_AREA]; // Covers frames of key_exc_ell() + chat()
+ crypto_wipe(area, STACK_WIPE_AREA);
+}
+////////////////////////////////
+////////////////////////////////
+
 ////////////////////////////////
 /// Main for socket creation ///
 ////////////////////////////////
@@ -518,65 +754,131 @@ int main()
   chip_uart_init();
  #endif
 
- /*
- Loop for the MCU platform because
- we don’t want to reload the MCU to reuse it,
- but due to the design of some functions, we need to
- fully reboot the system after it has been used 6 times. 
- This is why this loop counts iterations defined by macro LIVE_COUNT.
+ /* Begin initialization of the Wiznet chip */
+ wiznet_chip_init_start();
+
+ /* Seed the XDRBG from the MCU's sources of entropy */
+ random_init();
+
+ /* Core1 fills the keypair pool while the user goes through the menus */
+ keypool_start();
+ core1_start();
+
+ /* Wait for user input(UART or USB)*/
+ #if PICO_STDIO_USB_ENABLE
+   user_await_usb();
+ #else
+   user_await_uart();
+ #endif
+
+ /* 
+ Complete the chip initialization. 
+ Ensure the MCU is connected to the server via Ethernet 
  */
- for(int i = 0; i<LIVE_COUNT; i++) {
+ wiznet_chip_init_end();
 
-    /* Begin initialization of the Wiznet chip */
-    wiznet_chip_init_start();
+ /* Increment every 1ms "g_msec_cnt" variable(registered only once) */
+ wizchip_1ms_timer_initialize(repeating_timer_callback);
 
-    /* Seed the XDRBG from the MCU's sources of entropy */
-    random_init();
+ /*
+ Network settings of the sessions, static because they must keep 
+ their values when a transport error returns here by longjmp.
+ */
+ static wiz_NetInfo your_net_info;
+ static int port;
+ static uint8_t ip[NET_DATA_SIZE];
+ static int network_ready = NO;
 
-    /* Wait for user input(UART or USB)*/
-    #if PICO_STDIO_USB_ENABLE
-      user_await_usb();
-    #else
-      user_await_uart();
-    #endif
+ /*
+ Loop of the sessions. Chip, 1ms timer, DHCP client and XDRBG are 
+ initialized once above and reused by every session, so the next session 
+ starts with the PIN prompt(network settings are asked only after "net").
+ */
+ while (1) {
 
-    /* 
-    Complete the chip initialization. 
-    Ensure the MCU is connected to the server via Ethernet 
+    /*
+    Recovery point: transport errors(lost connection, failed connect,
+    DHCP failure, see error.h) continue here instead of rebooting. 
+    Socket is closed and the server is dialed again with the same 
+    network settings and XDRBG state.
     */
-    wiznet_chip_init_end();
+    if (setjmp(error_recovery) != OK) {
+        sockct_cls(SOCKET_NUM);
+        wipe_stack(); // Keys of the broken session are left on stack
+        sleep_ms(RECONNECT_DELAY);
+    }
+    recovery_arm();
 
-    /* Get network information from user */
-    wiz_NetInfo your_net_info = choose_net_data();
+    if (network_ready == NO) {
+        /* Get network information from user */
+        your_net_info = choose_net_data();
  
-    /* Initialize and print network data */
-    network_initialize(your_net_info);
-    print_network_information(your_net_info);
-    
-    /* Increment every 1ms "g_msec_cnt" variable */
-    wizchip_1ms_timer_initialize(repeating_timer_callback);
+        /* Initialize and print network data */
+        network_initialize(your_net_info);
+        print_network_information(your_net_info);
  
-    /*Copy default port in case user didn`t provided custom port*/
-    int port = PORT; 
+        /*Copy default port in case user didn`t provided custom port*/
+        port = PORT; 
 
-    /*Copy default IP in case user didn`t provided custom IP*/
-    uint8_t ip[] = IP;
+        /*Copy default IP in case user didn`t provided custom IP*/
+        uint8_t default_ip[] = IP;
+        memcpy(ip, default_ip, NET_DATA_SIZE);
     
-    /*Configuring ip of server and port number*/
-    choose_server_port(ip, &port);
+        /*Configuring ip of server and port number*/
+        choose_server_port(ip, &port);
+        network_ready = YES;
+    }
+
+    /* 
+    PIN is asked before connecting, Argon2i then runs on core1 during
+    DHCP renewal, connect and the first key exchange 
+    */
+    pin_unlock_start();
+
+    /* DHCP lease is renewed between sessions */
+    if (dhcp_maintain(&your_net_info) == YES) {
+        network_initialize(your_net_info);
+        print_network_information(your_net_info);
+    }
      
     int sockfd = sockct_opn(port,ip);
 
     key_exc_ell(sockfd); //Entering "key exchange" stage
 
     sockct_cls(sockfd);
+    recovery_disarm(YES); // Session ended normally
+
+    /* Server accepted the key, calibrated Argon2i can be stored */
+    pin_calibrate_commit();
+    pin_cache_confirm(); // Next session can skip PIN and Argon2i
 
-    printf("Program ended, press Enter:"); //End of program
-    getchar();
+    /* 
+    Typing "trace" prints phase timings of the session as CSV,
+    "net" asks for network and server settings again,
+    "calibrate" chooses Argon2i parameters for ARGON2_TARGET_MS.
+    */
+    printf("Session ended, press Enter to start a new one(\"net\" - change network, \"trace\" - timings, \"calibrate\" - Argon2i):");
+    char answer[ANS_SIZE];
+    if (fgets(answer, ANS_SIZE, stdin) == NULL) {
+        watchdog_reboot(0, 0, 0); // Terminal is gone, nothing to serve
+    }
+    if (strncmp(answer, "trace", strlen("trace")) == 0) {
+        trace_dump();
+        random_stats(); // Keccak permutations saved by the XDRBG pools
+        keypool_stats();
+    }
+    if (strncmp(answer, "net", strlen("net")) == 0) {
+        network_ready = NO;
+    }
+    if (strncmp(answer, "calibrate", strlen("calibrate")) == 0) {
+        pin_calibrate();
+    }
 
+    /* Trace ring and random counters contain only the next session */
+    trace_reset();
+    random_stats_reset();
  }
 
- watchdog_reboot(0, 0, 0); //Rebooting system via watchdog
  return 0;
 }
 ////////////////////////////////
@@ -0,0 +1,439 @@
+// Client-server API(PICO)        //
+// Argon2 on two cores            //
+// Version 0.9.1pi                //
+// Bachelor's Work Project        //
+// Technical University of Kosice //
+// 17.10.2026                     //
+// Nikita Kuropatkin              //
+// Version for MCU                //
+// W5100S-EVB-Pico                //
+
+/*
+Argon2 fill of Monocypher(crypto_argon2() in monocypher.c) rewritten so
+segments of one slice can be filled by both cores. Helper functions
+(G rounds, extended hash, little endian loads) are copies of the static
+ones in monocypher.c, the order of operations is the same, so the output
+is identical for any number of lanes.
+*/
+#include <stdint.h>
+#include <stddef.h>
+#include "include/argon2_lanes.h"
+#include "include/monocypher.h"
+#include "include/parameters.h" //Macros are defined here
+#include "hardware/sync.h"
+
+/*
+Argon2 operates on 1024 byte blocks.
+*/
+typedef struct { uint64_t a[128]; } argon2_block;
+
+/*
+State of the running argon2_lanes(), shared by the cores.
+Pass, slice and segment counters are changed only under `argon2_lock`.
+`run_next` is the next free segment of the slice, `run_done` is the count
+of finished segments of the slice.
+*/
+static spin_lock_t *argon2_lock = NULL;
+static argon2_block *run_blocks;
+static crypto_argon2_config run_config;
+static uint32_t run_segment_size;
+static uint32_t run_lane_size;
+static uint32_t run_nb_blocks;
+static volatile int run_active = NO;
+static volatile uint32_t run_pass;
+static volatile uint32_t run_slice;
+static volatile uint32_t run_next;
+static volatile uint32_t run_done;
+
+/////////////////////////
+///  Helper functions ///
+/////////////////////////
+static void store32_le(uint8_t out[4], uint32_t in)
+{
+ out[0] =  in        & 0xff;
+ out[1] = (in >>  8) & 0xff;
+ out[2] = (in >> 16) & 0xff;
+ out[3] = (in >> 24) & 0xff;
+}
+
+static void load64_le_buf(uint64_t *dst, const uint8_t *src, size_t size)
+{
+ for (size_t i = 0; i < size; i++) {
+    dst[i] = 0;
+    for (int b = 7; b >= 0; b--) {
+       dst[i] = (dst[i] << 8) | src[i * 8 + b];
+    }
+ }
+}
+
+static void store64_le_buf(uint8_t *dst, const uint64_t *src, size_t size)
+{
+ for (size_t i = 0; i < size; i++) {
+    store32_le(dst + i * 8, (uint32_t)src[i]);
+    store32_le(dst + i * 8 + 4, (uint32_t)(src[i] >> 32));
+ }
+}
+
+static uint64_t rotr64(uint64_t x, uint64_t n) { return (x >> n) ^ (x << (64 - n)); }
+
+/*
+Updates a BLAKE2 hash with a 32 bit word, little endian.
+*/
+static void blake_update_32(crypto_blake2b_ctx *ctx, uint32_t input)
+{
+ uint8_t buf[4];
+ store32_le(buf, input);
+ crypto_blake2b_update(ctx, buf, 4);
+ crypto_wipe(buf, 4);
+}
+
+static void blake_update_32_buf(crypto_blake2b_ctx *ctx, const uint8_t *buf, uint32_t size)
+{
+ blake_update_32(ctx, size);
+ crypto_blake2b_update(ctx, buf, size);
+}
+
+static void copy_block(argon2_block *o, const argon2_block *in)
+{
+ for (int i = 0; i < 128; i++) o->a[i] = in->a[i];
+}
+
+static void xor_block(argon2_block *o, const argon2_block *in)
+{
+ for (int i = 0; i < 128; i++) o->a[i] ^= in->a[i];
+}
+
+/*
+Hash with a virtually unlimited digest size(H' of the specification).
+*/
+static void extended_hash(uint8_t *digest, uint32_t digest_size,
+                          const uint8_t *input, uint32_t input_size)
+{
+ crypto_blake2b_ctx ctx;
+ crypto_blake2b_init(&ctx, digest_size < 64 ? digest_size : 64);
+ blake_update_32(&ctx, digest_size);
+ crypto_blake2b_update(&ctx, input, input_size);
+ crypto_blake2b_final(&ctx, digest);
+
+ if (digest_size > 64) {
+    uint32_t r   = (uint32_t)(((uint64_t)digest_size + 31) >> 5) - 2;
+    uint32_t i   =  1;
+    uint32_t in  =  0;
+    uint32_t out = 32;
+    while (i < r) {
+       // Input and output overlap. This is intentional
+       crypto_blake2b(digest + out, 64, digest + in, 64);
+       i   +=  1;
+       in  += 32;
+       out += 32;
+    }
+    crypto_blake2b(digest + out, digest_size - (32 * r), digest + in, 64);
+ }
+}
+
+#define LSB(x) ((uint64_t)(uint32_t)x)
+#define G(a, b, c, d) \
+ a += b + ((LSB(a) * LSB(b)) << 1);  d ^= a;  d = rotr64(d, 32); \
+ c += d + ((LSB(c) * LSB(d)) << 1);  b ^= c;  b = rotr64(b, 24); \
+ a += b + ((LSB(a) * LSB(b)) << 1);  d ^= a;  d = rotr64(d, 16); \
+ c += d + ((LSB(c) * LSB(d)) << 1);  b ^= c;  b = rotr64(b, 63)
+#define ROUND(v0,  v1,  v2,  v3,  v4,  v5,  v6,  v7, \
+              v8,  v9, v10, v11, v12, v13, v14, v15) \
+ G(v0, v4,  v8, v12);  G(v1, v5,  v9, v13); \
+ G(v2, v6, v10, v14);  G(v3, v7, v11, v15); \
+ G(v0, v5, v10, v15);  G(v1, v6, v11, v12); \
+ G(v2, v7,  v8, v13);  G(v3, v4,  v9, v14)
+
+/*
+Core of the compression function G. Computes Z from R in place.
+*/
+static void g_rounds(argon2_block *b)
+{
+ // column rounds (work_block = Q)
+ for (int i = 0; i < 128; i += 16) {
+    ROUND(b->a[i   ], b->a[i+ 1], b->a[i+ 2], b->a[i+ 3],
+          b->a[i+ 4], b->a[i+ 5], b->a[i+ 6], b->a[i+ 7],
+          b->a[i+ 8], b->a[i+ 9], b->a[i+10], b->a[i+11],
+          b->a[i+12], b->a[i+13], b->a[i+14], b->a[i+15]);
+ }
+ // row rounds (b = Z)
+ for (int i = 0; i < 16; i += 2) {
+    ROUND(b->a[i   ], b->a[i+ 1], b->a[i+ 16], b->a[i+ 17],
+          b->a[i+32], b->a[i+33], b->a[i+ 48], b->a[i+ 49],
+          b->a[i+64], b->a[i+65], b->a[i+ 80], b->a[i+ 81],
+          b->a[i+96], b->a[i+97], b->a[i+112], b->a[i+113]);
+ }
+}
+/////////////////////////
+/////////////////////////
+
+/////////////////////////
+///   Segment filling ///
+/////////////////////////
+/*
+Fills one segment(blocks of one lane in one slice), the loop body of
+crypto_argon2() for a single `segment`. Segments of the same slice
+are independent, so they can run on different cores.
+*/
+static void fill_segment(const uint32_t pass, const uint32_t slice, const uint32_t segment)
+{
+ const crypto_argon2_config config = run_config;
+ const uint32_t segment_size = run_segment_size;
+ const uint32_t lane_size = run_lane_size;
+ argon2_block *blocks = run_blocks;
+
+ // On the first slice of the first pass, blocks 0 and 1 are already filled
+ uint32_t pass_offset  = pass == 0 && slice == 0 ? 2 : 0;
+ uint32_t slice_offset = slice * segment_size;
+
+ // Argon2i and Argon2id start with constant time indexing,
+ // Argon2id switches after the first two slices of the first pass
+ int constant_time = config.algorithm == CRYPTO_ARGON2_I ||
+                     (config.algorithm == CRYPTO_ARGON2_ID && pass == 0 && slice < 2);
+
+ argon2_block tmp;
+ argon2_block index_block;
+ uint32_t index_ctr = 1;
+ for (uint32_t block = pass_offset; block < segment_size; block++) {
+    // Current and previous blocks
+    uint32_t lane_offset = segment * lane_size;
+    argon2_block *segment_start = blocks + lane_offset + slice_offset;
+    argon2_block *current  = segment_start + block;
+    argon2_block *previous =
+       block == 0 && slice_offset == 0
+       ? segment_start + lane_size - 1
+       : segment_start + block - 1;
+
+    uint64_t index_seed;
+    if (constant_time) {
+       if (block == pass_offset || (block % 128) == 0) {
+          // Fill or refresh deterministic indices block
+          for (int i = 0; i < 128; i++) index_block.a[i] = 0;
+          index_block.a[0] = pass;
+          index_block.a[1] = segment;
+          index_block.a[2] = slice;
+          index_block.a[3] = run_nb_blocks;
+          index_block.a[4] = config.nb_passes;
+          index_block.a[5] = config.algorithm;
+          index_block.a[6] = index_ctr;
+          index_ctr++;
+
+          // ... then shuffle it
+          copy_block(&tmp, &index_block);
+          g_rounds  (&index_block);
+          xor_block (&index_block, &tmp);
+          copy_block(&tmp, &index_block);
+          g_rounds  (&index_block);
+          xor_block (&index_block, &tmp);
+       }
+       index_seed = index_block.a[block % 128];
+    }
+    else {
+       index_seed = previous->a[0];
+    }
+
+    // Reference set: the last 3 slices(if they exist yet) and
+    // the already constructed blocks in the current segment
+    uint32_t next_slice   = ((slice + 1) % 4) * segment_size;
+    uint32_t window_start = pass == 0 ? 0     : next_slice;
+    uint32_t nb_segments  = pass == 0 ? slice : 3;
+    uint32_t lane         =
+       pass == 0 && slice == 0
+       ? segment
+       : (uint32_t)((index_seed >> 32) % config.nb_lanes);
+    uint32_t window_size  =
+       nb_segments * segment_size +
+       (lane  == segment ? block - 1 :
+        block == 0       ? (uint32_t)-1 : 0);
+
+    // Find reference block
+    uint64_t j1 = index_seed & 0xffffffff; // block selector
+    uint64_t x  = (j1 * j1) >> 32;
+    uint64_t y  = (window_size * x) >> 32;
+    uint64_t z  = (window_size - 1) - y;
+    uint32_t ref   = (uint32_t)((window_start + z) % lane_size);
+    uint32_t index = lane * lane_size + ref;
+    argon2_block *reference = blocks + index;
+
+    // Shuffle the previous & reference block into the current block
+    copy_block(&tmp, previous);
+    xor_block (&tmp, reference);
+    if (pass == 0) { copy_block(current, &tmp); }
+    else           { xor_block (current, &tmp); }
+    g_rounds  (&tmp);
+    xor_block (current, &tmp);
+ }
+ crypto_wipe(&tmp, sizeof(tmp));
+ crypto_wipe(&index_block, sizeof(index_block));
+}
+
+/*
+Takes the next free segment of the current slice and fills it.
+Returns NO if all segments of the slice were already taken
+(or nothing runs), YES after the segment was filled.
+*/
+static int fill_next_segment(void)
+{
+ uint32_t save = spin_lock_blocking(argon2_lock);
+ if (run_active == NO || run_next >= run_config.nb_lanes) {
+    spin_unlock(argon2_lock, save);
+    return NO;
+ }
+ uint32_t pass = run_pass;
+ uint32_t slice = run_slice;
+ uint32_t segment = run_next++;
+ spin_unlock(argon2_lock, save);
+
+ fill_segment(pass, slice, segment);
+
+ save = spin_lock_blocking(argon2_lock);
+ run_done++;
+ spin_unlock(argon2_lock, save);
+ __sev(); // Wake up the core waiting for the end of the slice
+ return YES;
+}
+/////////////////////////
+/////////////////////////
+
+/////////////////////////
+///  Argon2 interface ///
+/////////////////////////
+/*
+Argon2 with the same parameters and output as crypto_argon2().
+Segments are shared with the core that calls argon2_lanes_help(),
+without it all lanes are filled by this core. Only one call can
+run at a time.
+Parameters:
+- `hash`: Output hash(`hash_size` bytes).
+- `work_area`: Memory of `config.nb_blocks` KB, 8-byte aligned.
+- `config`, `inputs`, `extras`: Same as for crypto_argon2().
+*/
+void argon2_lanes(uint8_t *hash, uint32_t hash_size, void *work_area,
+                  crypto_argon2_config config,
+                  crypto_argon2_inputs inputs,
+                  crypto_argon2_extras extras)
+{
+ if (argon2_lock == NULL) {
+    argon2_lock = spin_lock_instance((unsigned int)spin_lock_claim_unused(true));
+ }
+
+ const uint32_t segment_size = config.nb_blocks / config.nb_lanes / 4;
+ const uint32_t lane_size    = segment_size * 4;
+ const uint32_t nb_blocks    = lane_size * config.nb_lanes; // rounding down
+
+ // work area seen as blocks (must be suitably aligned)
+ argon2_block *blocks = (argon2_block *)work_area;
+ {
+    uint8_t initial_hash[72]; // 64 bytes plus 2 words for future hashes
+    crypto_blake2b_ctx ctx;
+    crypto_blake2b_init (&ctx, 64);
+    blake_update_32     (&ctx, config.nb_lanes ); // p: number of "threads"
+    blake_update_32     (&ctx, hash_size);
+    blake_update_32     (&ctx, config.nb_blocks);
+    blake_update_32     (&ctx, config.nb_passes);
+    blake_update_32     (&ctx, 0x13);             // v: version number
+    blake_update_32     (&ctx, config.algorithm); // y: Argon2i, Argon2d...
+    blake_update_32_buf (&ctx, inputs.pass, inputs.pass_size);
+    blake_update_32_buf (&ctx, inputs.salt, inputs.salt_size);
+    blake_update_32_buf (&ctx, extras.key,  extras.key_size);
+    blake_update_32_buf (&ctx, extras.ad,   extras.ad_size);
+    crypto_blake2b_final(&ctx, initial_hash); // fill 64 first bytes only
+
+    // fill first 2 blocks of each lane
+    uint8_t hash_area[1024];
+    for (uint32_t l = 0; l < config.nb_lanes; l++) {
+       for (uint32_t i = 0; i < 2; i++) {
+          store32_le(initial_hash + 64, i); // first  additional word
+          store32_le(initial_hash + 68, l); // second additional word
+          extended_hash(hash_area, 1024, initial_hash, 72);
+          load64_le_buf(blocks[l * lane_size + i].a, hash_area, 128);
+       }
+    }
+    crypto_wipe(initial_hash, sizeof(initial_hash));
+    crypto_wipe(hash_area, sizeof(hash_area));
+ }
+
+ // Publish the run, the other core can take segments from now on
+ uint32_t save = spin_lock_blocking(argon2_lock);
+ run_blocks = blocks;
+ run_config = config;
+ run_segment_size = segment_size;
+ run_lane_size = lane_size;
+ run_nb_blocks = nb_blocks;
+ run_pass = 0;
+ run_slice = 0;
+ run_next = 0;
+ run_done = 0;
+ run_active = YES;
+ spin_unlock(argon2_lock, save);
+ __sev();
+
+ for (uint32_t pass = 0; pass < config.nb_passes; pass++) {
+    for (uint32_t slice = 0; slice < 4; slice++) {
+       if (pass != 0 || slice != 0) {
+          save = spin_lock_blocking(argon2_lock);
+          run_pass = pass;
+          run_slice = slice;
+          run_next = 0;
+          run_done = 0;
+          spin_unlock(argon2_lock, save);
+          __sev(); // Next slice is ready for the other core
+       }
+
+       while (fill_next_segment() == YES);
+
+       // Barrier: all segments of the slice must be finished
+       while (1) {
+          save = spin_lock_blocking(argon2_lock);
+          uint32_t done = run_done;
+          spin_unlock(argon2_lock, save);
+          if (done == config.nb_lanes) break;
+          __wfe();
+       }
+    }
+ }
+
+ save = spin_lock_blocking(argon2_lock);
+ run_active = NO;
+ spin_unlock(argon2_lock, save);
+ __sev();
+
+ // XOR last blocks of each lane
+ argon2_block *last_block = blocks + lane_size - 1;
+ for (uint32_t lane = 1; lane < config.nb_lanes; lane++) {
+    argon2_block *next_block = last_block + lane_size;
+    xor_block(next_block, last_block);
+    last_block = next_block;
+ }
+
+ // Serialize last block
+ uint8_t final_block[1024];
+ store64_le_buf(final_block, last_block->a, 128);
+
+ // Wipe work area
+ crypto_wipe(work_area, (size_t)nb_blocks * 1024);
+
+ // Hash the very last block with H' into the output hash
+ extended_hash(hash, hash_size, final_block, 1024);
+ crypto_wipe(final_block, sizeof(final_block));
+}
+
+/*
+Fills free segments of the running argon2_lanes() on the calling core
+until it finishes. If nothing runs, waits for an event(WFE) and returns.
+*/
+void argon2_lanes_help(void)
+{
+ if (run_active == NO) {
+    __wfe();
+    return;
+ }
+ /*Lock is claimed before the run is published*/
+ while (run_active == YES) {
+    if (fill_next_segment() == NO) {
+       __wfe(); // Wait for the next slice
+    }
+ }
+}
+/////////////////////////
+/////////////////////////
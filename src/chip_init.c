@@ -46,7 +46,10 @@ USB for communication with the board.
 #if PICO_STDIO_USB_ENABLE
 void user_await_usb(void) {
  // Initialize TinyUSB, as we cannot use getchar() due to its blocking behavior 
- tusb_init();
+ // (only once, repeated tusb_init() registers the USB stack again)
+ if (!tusb_inited()) {
+    tusb_init();
+ }
    
  while (1) {
     // Send a welcome message over USB
@@ -16,6 +16,43 @@
 #include "../include/parameters.h" //Macros are defined here
 #include "../include/error.h"
 #include "../include/flash_reader.h"
+#include "../include/trace.h"
+#include "../include/core1.h"
+#include "../include/argon2_lanes.h"
+#include "../include/random.h" //Salt of calibrated parameters
+#include "pico/stdlib.h" //time_us_64()
+#include "hardware/sync.h" //Spin lock of the key cache
+
+#if BLOCK_AMOUNT < 8 * LANSES
+  #error "Argon2 needs at least 8 blocks(BLOCK_AMOUNT) per lane(LANSES)"
+#endif
+
+/*
+Largest work area of Argon2i in KB. Static work area has BLOCK_AMOUNT KB,
+so only the dynamic one can grow up to ARGON2_MAX_BLOCKS.
+*/
+#if ARGON2_MAX_BLOCKS < 8 * LANSES
+  #error "Argon2 needs at least 8 blocks(ARGON2_MAX_BLOCKS) per lane(LANSES)"
+#endif
+#if ALLOCATION == DYNAMIC
+  #define PIN_MAX_BLOCKS ARGON2_MAX_BLOCKS
+#else
+  #define PIN_MAX_BLOCKS BLOCK_AMOUNT
+#endif
+
+/*
+Argon2i parameters chosen by pin_calibrate(). The unlock of the next 
+session keeps the PIN and the unlocked key(`pending_pin`, `pending_key`),
+pin_calibrate_commit() secures the key with the new parameters and 
+`pending_salt` after the server accepted the key(session ended normally),
+so Argon2i runs once more only then, not during the unlock.
+*/
+static int calibration_pending = NO;
+static int pending_ready = NO;
+static crypto_argon2_config pending_config;
+static uint8_t pending_pin[PINSZ];
+static uint8_t pending_key[KEYSZ];
+static uint8_t pending_salt[SALTSZ];
 
 /*
 This function takes an input key and a hashed PIN, and performs an 
@@ -42,10 +79,59 @@ static void xor_with_key(uint8_t *result_key, const uint8_t *working_key, const
 /////////////////////////////////////////////////
 /////////////////////////////////////////////////
 
+/*
+Reads a 32-bit little-endian value of the stored Argon2i parameters.
+*/
+static uint32_t load_le32(const uint8_t *src)
+{
+ return (uint32_t)src[0] | ((uint32_t)src[1] << 8) |
+        ((uint32_t)src[2] << 16) | ((uint32_t)src[3] << 24);
+}
+
+/*
+Writes a 32-bit little-endian value of the stored Argon2i parameters.
+*/
+static void store_le32(uint8_t *dst, const uint32_t value)
+{
+ dst[0] = (uint8_t)value;
+ dst[1] = (uint8_t)(value >> 8);
+ dst[2] = (uint8_t)(value >> 16);
+ dst[3] = (uint8_t)(value >> 24);
+}
+
+/*
+Returns the Argon2i configuration of the key in flash: parameters stored 
+by calibration after the salt(PARAMS_OFFSET), or BLOCK_AMOUNT, ITERATIONS 
+and LANSES if there are none or they do not fit this build.
+*/
+static crypto_argon2_config pin_config(void)
+{
+ crypto_argon2_config config = {
+    .algorithm = CRYPTO_ARGON2_I, /* Variant of Argon*/
+    .nb_blocks = BLOCK_AMOUNT,    /* The number of blocks for work area*/
+    .nb_passes = ITERATIONS,               /*iterations*/
+    .nb_lanes  = LANSES                /* Lanes(1 - single-threaded)*/
+ };
+ uint8_t params[PARAMS_SIZE];
+ read_from_flash(PARAMS_OFFSET, params, PARAMS_SIZE);
+ uint32_t blocks = load_le32(&params[4]);
+ uint32_t passes = load_le32(&params[8]);
+ uint32_t lanes  = load_le32(&params[12]);
+ if (load_le32(params) == ARGON2_PARAMS_MAGIC && lanes > 0 && passes > 0 &&
+     blocks >= 8 * lanes && blocks <= PIN_MAX_BLOCKS) {
+    config.nb_blocks = blocks;
+    config.nb_passes = passes;
+    config.nb_lanes  = lanes;
+ }
+ return config;
+}
+/////////////////////////////////////////////////
+/////////////////////////////////////////////////
+
 /*
 This function takes an input PIN and hashes it using the Argon2i algorithm. 
-The Argon2i parameters used in this function are predefined in the code and 
-can be modified, but changes should be made with caution to ensure security 
+The Argon2i parameters come from pin_config()(flash or parameters.h) or 
+from calibration, changes should be made with caution to ensure security 
 and proper functioning.
 The function uses Argon2i to hash the `pin` with the provided `salt` and 
 stores the result in the `hashed_pin`.
@@ -54,15 +140,10 @@ Parameters:
 - `hashed_pin`: A pointer to the buffer where the resulting hashed PIN will 
   be stored.
 - `salt`: A pointer to the salt that will be used in the hashing process.
+- `config`: Argon2i parameters, at most PIN_MAX_BLOCKS blocks.
 */
-static void hashing_pin(uint8_t *pin, uint8_t *hashed_pin, uint8_t *salt) {
- /*Configuring Argon2 for PIN hashing*/
- crypto_argon2_config config = {
-    .algorithm = CRYPTO_ARGON2_I, /* Variant of Argon*/
-    .nb_blocks = BLOCK_AMOUNT,    /* The number of blocks for work area*/
-    .nb_passes = ITERATIONS,               /*iterations*/
-    .nb_lanes  = LANSES                /* Single-threaded*/
- };
+static void hashing_pin(uint8_t *pin, uint8_t *hashed_pin, uint8_t *salt, const crypto_argon2_config config) {
+ TRACE_BEGIN(trace_begin);
  crypto_argon2_inputs inputs = {
     .pass      = pin,                   /* User PIN*/
     .salt      = salt,                  /* Salt for the PIN*/
@@ -77,11 +158,11 @@ static void hashing_pin(uint8_t *pin, uint8_t *hashed_pin, uint8_t *salt) {
   Check parameters.h for more info about ALLOCATION macro
  */
  #if ALLOCATION == DYNAMIC
-   void *work_area = ALLOCATE_WORK_AREA((size_t)BLOCK_AMOUNT * 1024);
+   void *work_area = ALLOCATE_WORK_AREA((size_t)config.nb_blocks * 1024);
    if (work_area == NULL) {
     crypto_wipe(pin, PINSZ);//wiping PIN, cause it`s not longer needed
     crypto_wipe(salt, SALTSZ); //wiping salt, cause it`s not longer needed
-    exit_with_error(ALLOCATION_ERROR,"Memory allocation failed");
+    core_error(ALLOCATION_ERROR,"Memory allocation failed"); // Also on core1
    }
  #elif ALLOCATION == STATIC_BSS
    /* Static memory allocation on BSS segment */
@@ -90,33 +171,23 @@ static void hashing_pin(uint8_t *pin, uint8_t *hashed_pin, uint8_t *salt) {
    /* Static memory allocation on STACK segment */
    uint8_t work_area[BLOCK_AMOUNT * 1024] __attribute__((aligned(8)));
  #endif
- crypto_argon2(hashed_pin, HASHSZ, work_area,config, inputs, extras);
+ /*Same hash as crypto_argon2(), lanes can be filled also by the other core*/
+ argon2_lanes(hashed_pin, HASHSZ, work_area, config, inputs, extras);
  crypto_wipe(pin, PINSZ); //wiping PIN, cause it`s not longer needed
  crypto_wipe(salt, SALTSZ); //wiping salt, cause it`s not longer needed
  FREE_WORK_AREA(work_area); //free memory after usage of Argon
+ TRACE_END(TRACE_HASHING_PIN, trace_begin, config.nb_blocks);
 }
 /////////////////////////////////////////////////
 /////////////////////////////////////////////////
 
 /*
-This function prompts the user to enter their PIN. 
-The entered PIN is then XORed with key material stored in `client/secret.h`.
-If the PIN is correct, the client side will be authenticated. 
-If the PIN is incorrect, the communication will end.
-The function ensures that only users with the correct PIN can authenticate 
-successfully, allowing further communication to proceed.
+Prompts the user to enter the PIN and checks its format(PINSZ digits).
 Parameters:
-- `plain_key`: A pointer to the key material that will be XORed with 
-the entered PIN. This key is used for authentication.
+- `pin`: A pointer to the buffer(NONSZ bytes) where the PIN is stored.
 */
-void pin_checker(uint8_t *plain_key) {
- char pin[NONSZ]; // bigger size for checking
- uint8_t hashed_pin[HASHSZ]; //hashed value of pin
- /*Key secured by PIN that contained in src/client/key.txt*/
- uint8_t secured_key[KEYSZ];
- /*Salt for PIN hashing(contained in src/client/salt.txt)*/
- uint8_t salt[SALTSZ];
-
+static void pin_enter(char *pin) {
+ TRACE_BEGIN(trace_begin);
  printf("Enter PIN: ");
  fgets(pin, NONSZ, stdin); // getting pin
 
@@ -135,16 +206,379 @@ void pin_checker(uint8_t *plain_key) {
  if (pin[len] != '\n' || len != PINSZ) {
     exit_with_error(WRONG_PIN,"You entered wrong PIN");
  }
+ TRACE_END(TRACE_PIN_CHECKER, trace_begin, PINSZ);
+}
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+
+/*
+Reads the secured key, salt and Argon2i parameters from flash, hashes 
+the PIN with Argon2i and XORs the hash with the secured key. If
+calibration is pending, the PIN and the key are kept for 
+pin_calibrate_commit(). Wipes the PIN.
+Parameters:
+- `pin`: A pointer to the PIN entered by the user.
+- `plain_key`: A pointer to the buffer for the unlocked key.
+*/
+static void pin_unlock(char *pin, uint8_t *plain_key) {
+ uint8_t hashed_pin[HASHSZ]; //hashed value of pin
+ /*Key secured by PIN that contained in src/client/key.txt*/
+ uint8_t secured_key[KEYSZ];
+ /*Salt for PIN hashing(contained in src/client/salt.txt)*/
+ uint8_t salt[SALTSZ];
+
+ pending_ready = NO;
+ if (calibration_pending == YES) {
+    memcpy(pending_pin, pin, PINSZ); // hashing_pin() wipes PIN
+ }
 
  read_from_flash(KEY_OFFSET, secured_key, KEYSZ); //Reading key from flash
 
  read_from_flash(SALT_OFFSET, salt, SALTSZ); //Reading salt from flash
  
- hashing_pin((uint8_t*)pin, hashed_pin, salt); // hashing with ARGON2
+ hashing_pin((uint8_t*)pin, hashed_pin, salt, pin_config()); // hashing with ARGON2
  
  /*XORing resulted hash with key-material*/
  xor_with_key(plain_key, secured_key, (uint8_t*)hashed_pin); 
+
+ if (calibration_pending == YES) {
+    memcpy(pending_key, plain_key, KEYSZ);
+    pending_ready = YES;
+ }
+ crypto_wipe(hashed_pin, HASHSZ);
+ crypto_wipe(pin, NONSZ);
 }
 ///////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////
 
+/*
+This function prompts the user to enter their PIN. 
+The entered PIN is then XORed with key material stored in `client/secret.h`.
+If the PIN is correct, the client side will be authenticated. 
+If the PIN is incorrect, the communication will end.
+The function ensures that only users with the correct PIN can authenticate 
+successfully, allowing further communication to proceed.
+Parameters:
+- `plain_key`: A pointer to the key material that will be XORed with 
+the entered PIN. This key is used for authentication.
+*/
+void pin_checker(uint8_t *plain_key) {
+ char pin[NONSZ]; // bigger size for checking
+ pin_enter(pin);
+ pin_unlock(pin, plain_key);
+}
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+
+/*
+PIN and unlocked key of the background unlock, shared between the cores.
+Core1 writes `unlock_key` only while its job runs, core0 reads it only
+after core1_wait().
+*/
+static char unlock_pin[NONSZ];
+static uint8_t unlock_key[KEYSZ];
+static int unlock_cached = NO; // `unlock_key` was taken from the key cache
+
+/*
+Cache of the unlocked key between sessions(KEY_CACHE_TIMEOUT). The key is
+kept XORed with a random mask generated once per boot, never in plain.
+States: CACHE_EMPTY, CACHE_USED(key of the running session, not yet
+accepted by the server), CACHE_READY(usable by the next session).
+`cache_idle` counts seconds in CACHE_READY, it is increased by the 1ms 
+timer(pin_cache_tick()), so the state is guarded by a spin lock.
+*/
+#define CACHE_EMPTY 0
+#define CACHE_USED 1
+#define CACHE_READY 2
+static uint8_t cache_key[KEYSZ];
+static uint8_t cache_mask[KEYSZ];
+static volatile int cache_state = CACHE_EMPTY;
+static volatile uint32_t cache_idle = 0;
+static spin_lock_t *volatile cache_lock = NULL;
+
+/*
+Masks the unlocked key into the cache as the key of the running session
+(CACHE_USED), pin_cache_confirm() makes it usable for the next one.
+The mask is generated by XDRBG with the first stored key.
+Parameters:
+- `plain_key`: A pointer to the unlocked key.
+*/
+static void pin_cache_store(const uint8_t *plain_key) {
+ #if KEY_CACHE_TIMEOUT > 0
+   if (cache_lock == NULL) {
+      random_num(cache_mask, KEYSZ); // Per-boot mask
+      cache_lock = spin_lock_instance((unsigned int)spin_lock_claim_unused(true));
+   }
+   uint32_t save = spin_lock_blocking(cache_lock);
+   xor_with_key(cache_key, plain_key, cache_mask);
+   cache_state = CACHE_USED;
+   spin_unlock(cache_lock, save);
+ #else
+   (void)plain_key;
+ #endif
+}
+
+/*
+Unmasks the cached key into `unlock_key` if the cache is ready. The cache
+stays with the running session(CACHE_USED) until pin_cache_confirm().
+Returns YES if the key was taken, NO if the PIN must be entered.
+*/
+static int pin_cache_take(void) {
+ int taken = NO;
+ if (cache_lock == NULL) {
+    return NO; // No key was ever cached
+ }
+ uint32_t save = spin_lock_blocking(cache_lock);
+ if (cache_state == CACHE_READY) {
+    xor_with_key(unlock_key, cache_key, cache_mask);
+    cache_state = CACHE_USED;
+    taken = YES;
+ }
+ spin_unlock(cache_lock, save);
+ return taken;
+}
+
+/*
+Job of core1: Argon2i hashing of the entered PIN and unlocking of the key.
+*/
+static void pin_unlock_job(void) {
+ pin_unlock(unlock_pin, unlock_key);
+}
+
+/*
+Prompts the user to enter the PIN and starts hashing of it on core1, 
+so Argon2i runs while core0 connects to the server and exchanges keys.
+The result is taken by pin_unlock_wait().
+*/
+void pin_unlock_start(void) {
+ core1_wait(); // Job of a broken session may still run
+ if (pin_cache_take() == YES) {
+    unlock_cached = YES;
+    printf("Key unlocked from cache(PIN is asked again after %d s idle)\n", KEY_CACHE_TIMEOUT);
+    return;
+ }
+ unlock_cached = NO;
+ pin_enter(unlock_pin);
+ core1_submit(pin_unlock_job);
+}
+
+/*
+Waits until core1 unlocked the key started by pin_unlock_start(), 
+then moves the key to `plain_key` and wipes the shared copy.
+Parameters:
+- `plain_key`: A pointer to the buffer for the unlocked key.
+*/
+void pin_unlock_wait(uint8_t *plain_key) {
+ TRACE_BEGIN(trace_begin);
+ /*
+ Core0 fills lanes of Argon2i together with core1 until the job ends
+ (lanes of the key in flash can differ from LANSES after calibration)
+ */
+ while (core1_busy() == YES) {
+    argon2_lanes_help();
+ }
+ core1_wait();
+ memcpy(plain_key, unlock_key, KEYSZ);
+ crypto_wipe(unlock_key, KEYSZ);
+ if (unlock_cached == NO) {
+    pin_cache_store(plain_key);
+ }
+ TRACE_END(TRACE_PIN_WAIT, trace_begin, unlock_cached);
+}
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+
+/*
+Makes the key of the session usable for the next session and starts 
+its idle timeout. Called after the server accepted the key(session
+ended normally), so a key unlocked by a wrong PIN is never reused.
+*/
+void pin_cache_confirm(void) {
+ if (cache_lock == NULL) {
+    return;
+ }
+ uint32_t save = spin_lock_blocking(cache_lock);
+ if (cache_state == CACHE_USED) {
+    cache_state = CACHE_READY;
+    cache_idle = 0;
+ }
+ spin_unlock(cache_lock, save);
+}
+
+/*
+Wipes the cached key, the next session asks for the PIN. The PIN and key
+kept for pin_calibrate_commit() are wiped too.
+Called on errors(exit_with_error()), calibration and idle timeout.
+*/
+void pin_cache_wipe(void) {
+ crypto_wipe(pending_pin, PINSZ);
+ crypto_wipe(pending_key, KEYSZ);
+ pending_ready = NO;
+ if (cache_lock == NULL) {
+    return;
+ }
+ uint32_t save = spin_lock_blocking(cache_lock);
+ crypto_wipe(cache_key, KEYSZ);
+ cache_state = CACHE_EMPTY;
+ spin_unlock(cache_lock, save);
+}
+
+/*
+Counts idle seconds of the ready cache and wipes it after
+KEY_CACHE_TIMEOUT seconds. Called every second by the 1ms timer(timing.c).
+*/
+void pin_cache_tick(void) {
+ if (cache_lock == NULL) {
+    return;
+ }
+ uint32_t save = spin_lock_blocking(cache_lock);
+ if (cache_state == CACHE_READY && ++cache_idle >= KEY_CACHE_TIMEOUT) {
+    crypto_wipe(cache_key, KEYSZ);
+    cache_state = CACHE_EMPTY;
+ }
+ spin_unlock(cache_lock, save);
+}
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+
+/*
+Runs crypto_argon2() on this core with dummy inputs and returns its 
+time in microseconds.
+Parameters:
+- `work_area`: Memory of at least `blocks` KB.
+- `blocks`: Number of blocks(KB).
+- `passes`: Number of passes.
+*/
+static uint64_t calibrate_run(void *work_area, const uint32_t blocks, const uint32_t passes) {
+ uint8_t hash[HASHSZ];
+ uint8_t pass[PINSZ] = {0};
+ uint8_t salt[SALTSZ] = {0};
+ crypto_argon2_config config = {
+    .algorithm = CRYPTO_ARGON2_I,
+    .nb_blocks = blocks,
+    .nb_passes = passes,
+    .nb_lanes  = LANSES
+ };
+ crypto_argon2_inputs inputs = {
+    .pass      = pass,
+    .salt      = salt,
+    .pass_size = PINSZ,
+    .salt_size = SALTSZ
+ };
+ uint64_t begin = time_us_64();
+ crypto_argon2(hash, HASHSZ, work_area, config, inputs, crypto_argon2_no_extras);
+ return time_us_64() - begin;
+}
+
+/*
+Benchmarks Argon2i on the running board and chooses parameters for 
+ARGON2_TARGET_MS: the largest power-of-two fraction of PIN_MAX_BLOCKS
+that fits ARGON2_MIN_PASSES passes, then the most passes that fit.
+Time of a pass and of the fixed part(initial and final hashing) are
+taken from runs with 1 and 2 passes, the result is checked by a run 
+with the chosen parameters. Time is measured on core0 alone, so with 
+LANSES > 1 the unlock with core1 helping takes less.
+The parameters are only kept in RAM, the key of the next session(it
+needs the right PIN) is secured with them and stored by 
+pin_calibrate_commit(). The work area follows ALLOCATION like hashing_pin().
+*/
+void pin_calibrate(void) {
+ const uint64_t target_us = (uint64_t)ARGON2_TARGET_MS * 1000;
+ uint32_t blocks = PIN_MAX_BLOCKS;
+ uint32_t passes = 0;
+ uint64_t time_us = 0;
+
+ printf("Argon2i calibration for %d ms, up to %d KB...\n", ARGON2_TARGET_MS, PIN_MAX_BLOCKS);
+ #if ALLOCATION == DYNAMIC
+   void *work_area = ALLOCATE_WORK_AREA((size_t)PIN_MAX_BLOCKS * 1024);
+   if (work_area == NULL) {
+      exit_with_error(ALLOCATION_ERROR,"Memory allocation failed");
+   }
+ #elif ALLOCATION == STATIC_BSS
+   static uint8_t work_area[PIN_MAX_BLOCKS * 1024] __attribute__((aligned(8)));
+ #else
+   uint8_t work_area[PIN_MAX_BLOCKS * 1024] __attribute__((aligned(8)));
+ #endif
+
+ while (1) {
+    uint64_t one_pass = calibrate_run(work_area, blocks, 1);
+    uint64_t pass_us  = calibrate_run(work_area, blocks, 2) - one_pass;
+    if (pass_us == 0) {
+       pass_us = 1;
+    }
+    uint64_t fixed_us = (one_pass > pass_us) ? one_pass - pass_us : 0;
+    passes = (target_us > fixed_us) ? (uint32_t)((target_us - fixed_us) / pass_us) : 0;
+    if (passes >= ARGON2_MIN_PASSES || blocks / 2 < 8 * LANSES) {
+       break;
+    }
+    blocks /= 2; // Too slow even for ARGON2_MIN_PASSES, less memory
+ }
+ if (passes < 1) {
+    passes = 1; // Target is too low for this board, the fastest setting
+ }
+
+ /*Estimate is checked by a real run, passes are lowered in proportion*/
+ time_us = calibrate_run(work_area, blocks, passes);
+ while (time_us > target_us && passes > 1) {
+    uint32_t fitting = (uint32_t)(passes * target_us / time_us);
+    passes = (fitting < passes) ? fitting : passes - 1;
+    if (passes < 1) {
+       passes = 1;
+    }
+    time_us = calibrate_run(work_area, blocks, passes);
+ }
+ FREE_WORK_AREA(work_area); //free memory after calibration
+
+ crypto_argon2_config current = pin_config();
+ printf("Argon2i: %lu KB, %lu passes, %lu lanes - %lu ms(now %lu KB, %lu passes)\n",
+        (unsigned long)blocks, (unsigned long)passes, (unsigned long)LANSES,
+        (unsigned long)(time_us / 1000),
+        (unsigned long)current.nb_blocks, (unsigned long)current.nb_passes);
+ printf("Key will be secured with them after the next session with the right PIN.\n");
+
+ pending_config.algorithm = CRYPTO_ARGON2_I;
+ pending_config.nb_blocks = blocks;
+ pending_config.nb_passes = passes;
+ pending_config.nb_lanes  = LANSES;
+ random_num(pending_salt, SALTSZ); // New salt for the new parameters
+ pending_ready = NO;
+ calibration_pending = YES;
+ pin_cache_wipe(); // Next session needs the PIN for the new parameters
+}
+
+/*
+Secures the key of the session with the calibrated parameters(one 
+Argon2i run of the kept PIN), then stores it, its salt and the
+parameters to the key page of flash. Must be called only after the 
+server accepted the unlocked key(MAC check in key_exc_ell()), because
+a wrong PIN unlocks a wrong key, which would be secured again.
+Does nothing if no calibration is pending.
+*/
+void pin_calibrate_commit(void) {
+ if (calibration_pending != YES || pending_ready != YES) {
+    return;
+ }
+ uint8_t hashed_pin[HASHSZ];
+ uint8_t salt[SALTSZ];
+ uint8_t page[PARAMS_OFFSET + PARAMS_SIZE];
+ memcpy(salt, pending_salt, SALTSZ); // hashing_pin() wipes salt
+ hashing_pin(pending_pin, hashed_pin, salt, pending_config); // Wipes PIN
+ xor_with_key(&page[KEY_OFFSET], pending_key, hashed_pin);
+ crypto_wipe(hashed_pin, HASHSZ);
+ memcpy(&page[SALT_OFFSET], pending_salt, SALTSZ);
+ store_le32(&page[PARAMS_OFFSET], ARGON2_PARAMS_MAGIC);
+ store_le32(&page[PARAMS_OFFSET + 4], pending_config.nb_blocks);
+ store_le32(&page[PARAMS_OFFSET + 8], pending_config.nb_passes);
+ store_le32(&page[PARAMS_OFFSET + 12], pending_config.nb_lanes);
+ write_to_flash(0, page, sizeof(page));
+
+ crypto_wipe(page, sizeof(page));
+ crypto_wipe(pending_key, KEYSZ);
+ crypto_wipe(pending_salt, SALTSZ);
+ pending_ready = NO;
+ calibration_pending = NO;
+ printf("Argon2i parameters and key stored to flash(%lu KB, %lu passes)\n",
+        (unsigned long)pending_config.nb_blocks, (unsigned long)pending_config.nb_passes);
+}
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
@@ -1,9 +1,9 @@
 // Client-server API(PICO)        //
 // Compression functions          //
-// Version 0.9.0pi                //
+// Version 0.9.1pi                //
 // Bachelor's Work Project        //
 // Technical University of Kosice //
-// 23.02.2025                     //
+// 17.10.2026                     //
 // Nikita Kuropatkin              //
 // Version for MCU                //
 // W5100S-EVB-Pico                //
@@ -11,8 +11,13 @@
 #include <string.h>
 #include <stdlib.h>
 #include "include/lzrw.h"
+#include "include/lzss.h"
+#include "include/lzrw3a16.h"
+#include "include/compress_decompress.h"
+#include "include/compress_dict.h"
 #include "include/error.h"
 #include "include/parameters.h" //Macros are defined here
+#include "include/trace.h"
 
 /////////////////////////////////////////////
 /// uint32_t to uint8_t Array Converter   ///
@@ -58,54 +63,307 @@ uint32_t from_byte_array( const uint8_t* byte_array, uint32_t number) {
 /////////////////////////////////////////////
 /////////////////////////////////////////////
 
+/////////////////////////////
+/// Compressor backends   ///
+/////////////////////////////
+_Static_assert(COMPRESS_LZRW3A_MEM == MEM_REQ, "COMPRESS_LZRW3A_MEM must match MEM_REQ of LZRW3a");
+_Static_assert(COMPRESS_HISTORY + BUFF_MAX < 0xFFFF, "LZSS positions in the history must fit 16 bits");
+
+/*
+Functions of LZRW3a with the interface of struct compress_backend. 
+LZRW3a keeps the history in its hash table(pointers), so `history` 
+is not needed.
+*/
+static void backend_lzrw3a_compress(uint8_t *wrk_mem, uint8_t *src, uint32_t src_len, uint8_t *dst, uint32_t *dst_len, uint32_t history)
+{
+ (void)history;
+ lzrw3a_stream_compress(wrk_mem, src, src_len, dst, dst_len);
+}
+
+static void backend_lzrw3a_decompress(uint8_t *wrk_mem, uint8_t *src, uint32_t src_len, uint8_t *dst, uint32_t dst_max, uint32_t *dst_len, uint32_t history)
+{
+ (void)history;
+ lzrw3a_stream_decompress(wrk_mem, src, src_len, dst, dst_max, dst_len);
+}
+
+/*
+The table points into the dictionary, it is only read(flash).
+*/
+static void backend_lzrw3a_prime(uint8_t *wrk_mem, const uint8_t *dict, uint32_t size)
+{
+ lzrw3a_stream_prime(wrk_mem, (uint8_t *)dict, size);
+}
+
+const struct compress_backend compress_lzrw3a = {
+ "LZRW3-A", COMPRESS_LZRW3A_MEM, lzrw3a_stream_reset,
+ backend_lzrw3a_compress, backend_lzrw3a_decompress, lzrw3a_stream_rebase,
+ backend_lzrw3a_prime
+};
+
+/*
+Functions of LZRW3a with 16-bit offsets(lzrw3a16.h), its table has
+2^LZRW3A16_TABLE_BITS entries.
+*/
+static void backend_lzrw3a16_init(uint8_t *wrk_mem)
+{
+ lzrw3a16_init(wrk_mem, LZRW3A16_TABLE_BITS);
+}
+
+static void backend_lzrw3a16_compress(uint8_t *wrk_mem, uint8_t *src, uint32_t src_len, uint8_t *dst, uint32_t *dst_len, uint32_t history)
+{
+ lzrw3a16_compress(wrk_mem, LZRW3A16_TABLE_BITS, src, src_len, dst, dst_len, history);
+}
+
+static void backend_lzrw3a16_decompress(uint8_t *wrk_mem, uint8_t *src, uint32_t src_len, uint8_t *dst, uint32_t dst_max, uint32_t *dst_len, uint32_t history)
+{
+ lzrw3a16_decompress(wrk_mem, LZRW3A16_TABLE_BITS, src, src_len, dst, dst_max, dst_len, history);
+}
+
+static void backend_lzrw3a16_rebase(uint8_t *wrk_mem, uint8_t *first, uint32_t used, uint32_t delta)
+{
+ (void)first; (void)used;
+ lzrw3a16_rebase(wrk_mem, LZRW3A16_TABLE_BITS, delta);
+}
+
+const struct compress_backend compress_lzrw3a16 = {
+ "LZRW3-A16", LZRW3A16_MEM(LZRW3A16_TABLE_BITS), backend_lzrw3a16_init,
+ backend_lzrw3a16_compress, backend_lzrw3a16_decompress, backend_lzrw3a16_rebase,
+ NULL
+};
+
+const struct compress_backend compress_lzss = {
+ "LZSS", LZSS_MEM, lzss_init, lzss_compress, lzss_decompress, lzss_rebase, NULL
+};
+/////////////////////////////
+/////////////////////////////
+
+/////////////////////////////
+/// Compression context   ///
+/////////////////////////////
+#if ALLOCATION == STATIC_BSS
+  /*Static memory allocation on BSS segment, shared by all contexts*/
+  static uint8_t bss_wrk_mem[COMPRESS_MEM] __attribute__((aligned(8)));
+#endif
+
+/*
+Context of the running session, released by compress_abort() when 
+exit_with_error() leaves chat() without returning(reconnect).
+*/
+static struct compress_ctx *compress_active = NULL;
+
+/*
+The function prepares the work memory of `ctx` for the backend 
+selected by COMPRESS_BACKEND. The program will exit if the allocation
+fails.
+*/
+void compress_init(struct compress_ctx *ctx)
+{
+ #if COMPRESS_BACKEND == LZSS
+   compress_init_backend(ctx, &compress_lzss, COMPRESS_STREAM);
+ #elif COMPRESS_BACKEND == LZRW3A16
+   compress_init_backend(ctx, &compress_lzrw3a16, COMPRESS_STREAM);
+ #else
+   compress_init_backend(ctx, &compress_lzrw3a, COMPRESS_STREAM);
+ #endif
+}
+
+/*
+Same as compress_init(), but with `backend` and `stream`(benchmarks).
+*/
+void compress_init_backend(struct compress_ctx *ctx, const struct compress_backend *backend, const int stream)
+{
+ uint32_t table_mem = (backend->mem + 7) & ~7;
+ ctx->backend = backend;
+ ctx->mem = COMPRESS_STREAM_MEM(backend->mem, stream);
+ /*
+  Working memory for compression.
+  The allocation type is determined based on the ALLOCATION flag.
+ */
+ #if ALLOCATION == DYNAMIC // Check parameters.h for more info about macros 
+   /* Dynamic memory allocation, once per session */
+   ctx->wrk_mem = ALLOCATE_WORK_AREA(ctx->mem); 
+   if (ctx->wrk_mem == NULL) {
+       exit_with_error(ALLOCATION_ERROR, "Memory allocation failed");
+   }
+ #else
+   if (ctx->mem > COMPRESS_MEM) {
+      exit_with_error(ALLOCATION_ERROR, "Memory allocation failed");
+   }
+   #if ALLOCATION == STATIC_BSS
+     ctx->wrk_mem = bss_wrk_mem;
+   #else
+     ctx->wrk_mem = ctx->area; // Static memory allocation on STACK segment
+   #endif
+ #endif
+ ctx->tx_table = ctx->wrk_mem;
+ ctx->tx_history = NULL;
+ ctx->rx_table = ctx->wrk_mem;
+ ctx->rx_history = NULL;
+ if (stream == YES) {
+    ctx->tx_history = ctx->tx_table + table_mem;
+    ctx->rx_table = ctx->tx_history + COMPRESS_HISTORY_MEM;
+    ctx->rx_history = ctx->rx_table + table_mem;
+ }
+ compress_active = ctx;
+ ctx->stream = stream;
+ ctx->dict = NULL;
+ ctx->dict_size = 0;
+ #if COMPRESS_DICT == YES
+   ctx->dict = compress_dict;
+   ctx->dict_size = compress_dict_size;
+ #endif
+ compress_reset(ctx);
+}
+
+/*
+The function prepares the work memory `table` of the backend for a block
+without history and primes it with the dictionary of `ctx`, if there is
+one and the backend can use it(COMPRESS_DICT). The dictionary is not 
+copied, the work memory points into it.
+*/
+static void compress_start(struct compress_ctx *ctx, uint8_t *table)
+{
+ ctx->backend->init(table);
+ if (ctx->dict != NULL && ctx->backend->prime != NULL) {
+    ctx->backend->prime(table, ctx->dict, ctx->dict_size);
+ }
+}
+
+/*
+The function drops the history of both directions, the next messages
+are compressed without it(only with the dictionary). Both sides must 
+reset at the same point(a new AEAD session).
+*/
+void compress_reset(struct compress_ctx *ctx)
+{
+ ctx->tx_used = 0;
+ ctx->rx_used = 0;
+ memset(ctx->wrk_mem, 0, ctx->mem); // Histories of the last session
+ compress_start(ctx, ctx->tx_table);
+ compress_start(ctx, ctx->rx_table);
+}
+
+/*
+The function drops the older half of a full history(more than 
+COMPRESS_HISTORY bytes) and rebases the work memory `table` of the 
+backend to the rest. Both sides slide before every message, so they 
+stay in step.
+*/
+static void compress_slide(const struct compress_backend *backend, uint8_t *table, uint8_t *history, uint32_t *used)
+{
+ if (*used <= COMPRESS_HISTORY) {
+    return;
+ }
+ uint32_t keep = COMPRESS_HISTORY / 2;
+ uint32_t delta = *used - keep;
+ memmove(history, history + delta, keep);
+ memset(history + keep, 0, delta);
+ backend->rebase(table, history, *used, delta);
+ *used = keep;
+}
+
+/*
+The function wipes and releases the work memory of `ctx`, the context 
+can be initialized again by compress_init().
+*/
+void compress_free(struct compress_ctx *ctx)
+{
+ if (ctx->wrk_mem == NULL) {
+    return;
+ }
+ /*Hash table points into the texts of the session*/
+ memset(ctx->wrk_mem, 0, ctx->mem);
+ FREE_WORK_AREA(ctx->wrk_mem);
+ ctx->wrk_mem = NULL;
+ if (compress_active == ctx) {
+    compress_active = NULL;
+ }
+}
+
+/*
+The function releases the context of the running session, if there is 
+one. Called by exit_with_error() while the owner is still on the stack.
+*/
+void compress_abort(void)
+{
+ if (compress_active != NULL) {
+    compress_free(compress_active);
+ }
+}
+/////////////////////////////
+/////////////////////////////
+
 /////////////////////////
 /// Text Compressors  ///
 /////////////////////////
 /*
-The function compresses `input_txt` using the LZRW3a algorithm,  
-and the compressed text is written to `output_txt`. 
+The function writes `input_txt` of `input_size` bytes as a stored 
+message(COMPRESS_STORED header) to `output_txt`.
+*/
+static void compress_store(const uint8_t *input_txt, const uint32_t input_size, uint8_t *output_txt, uint32_t *output_size)
+{
+ output_txt[0] = COMPRESS_STORED;
+ memcpy(output_txt + COMPRESS_HEADER, input_txt, input_size);
+ *output_size = input_size + COMPRESS_HEADER;
+}
+
+/*
+The function compresses `input_txt` using the backend of `ctx`
+(LZRW3a or LZSS), and the compressed text is written to `output_txt`. 
+Texts shorter than COMPRESS_MIN(parameters.h) are stored without 
+running the backend, longer ones are stored if the compressed form is 
+bigger, so the output is at most one byte longer than the text.
 This function takes the following parameters:  
+- `ctx` - compression context(compress_init()) with the work memory.  
 - `input_txt` - the uncompressed text to be compressed.  
 - `max_size` - the maximum size that the compressed text can have.  
 - `output_txt` - a pointer to the buffer where the compressed text 
   will be stored.  
 - `output_size` - a pointer to the size of the compressed text.  
 
-If the compressed text exceeds the size of `output_txt`, the program 
-will exit. This is highly unlikely, as the buffer is 100 characters larger 
-than `input_txt`. According to the LZRW3a documentation, the compressed text 
-should not be drastically larger than the input text. Based on experiments, 
-text with extremely high entropy (45 unique characters) expanded by less 
-than 10%, with the output text being 49 characters long.  
+If the output zone of the backend(COMPRESS_BOUND) exceeds `max_size`, 
+the program will exit. This can not happen for texts of TEXT_MAX, 
+as the buffer is 100 characters larger than `input_txt`. 
 For more information on LZRW3a, see:  
 LZRW3-A: http://www.ross.net/compression/lzrw3a.html
 */
-void compress_text(unsigned char *input_txt, const uint32_t max_size, unsigned  char *output_txt, uint32_t *output_size)
+void compress_text(struct compress_ctx *ctx, unsigned char *input_txt, const uint32_t max_size, unsigned  char *output_txt, uint32_t *output_size)
 {
- /*
-  Working memory for LZRW3a compression.
-  The allocation type is determined based on the ALLOCATION flag.
- */
- #if ALLOCATION == DYNAMIC // Check parameters.h for more info about macros 
-   /* Dynamic memory allocation */
-   void *wrk_mem = ALLOCATE_WORK_AREA(lzrw3a_req_mem()); 
-   if (wrk_mem == NULL) {
-       exit_with_error(ALLOCATION_ERROR, "Memory allocation failed");
-   }
- #elif ALLOCATION == STATIC_BSS
-   static uint8_t wrk_mem[MEM_REQ]; // Static memory allocation on BSS segment
- #else
-     uint8_t wrk_mem[MEM_REQ]; // Static memory allocation on STACK segment
- #endif
+ TRACE_BEGIN(trace_begin);
+ uint32_t input_size = strlen((const char *)input_txt);
+ uint8_t *src = input_txt;
+ uint32_t history = 0;
+
+ /*Output zone of the backend: header, text and control bytes*/
+ if (input_size > BUFF_MAX || COMPRESS_BOUND(input_size) > max_size) {
+    exit_with_error(TEXT_OVERFLOW, "Compressed text size is bigger than buffer");
+ }
 
- /*LZRW3a compress*/ 
- lzrw3a_compress(COMPRESS_ACTION_COMPRESS,wrk_mem,input_txt, strlen((const char *)input_txt),output_txt,output_size); 
+ /*Short texts would not get smaller, the backend is skipped*/
+ if (input_size < COMPRESS_MIN) {
+    compress_store(input_txt, input_size, output_txt, output_size);
+    TRACE_END(TRACE_COMPRESS, trace_begin, *output_size);
+    return;
+ }
 
- FREE_WORK_AREA(wrk_mem);
+ if (ctx->stream == YES) {
+    /*Text is compressed right after the history of sent messages*/
+    compress_slide(ctx->backend, ctx->tx_table, ctx->tx_history, &ctx->tx_used);
+    src = ctx->tx_history + ctx->tx_used;
+    memcpy(src, input_txt, input_size);
+    history = ctx->tx_used;
+    ctx->tx_used += input_size;
+ }
+ else {
+    compress_start(ctx, ctx->tx_table);
+ }
+ ctx->backend->compress(ctx->tx_table, src, input_size, output_txt, output_size, history);
 
- if (*output_size>max_size) {
-	exit_with_error(TEXT_OVERFLOW, "Compressed text size is bigger than buffer");
+ /*In stream mode the text stays in the history, the other side compresses it too*/
+ if (*output_size > input_size + COMPRESS_HEADER) {
+    compress_store(input_txt, input_size, output_txt, output_size);
  }
+ TRACE_END(TRACE_COMPRESS, trace_begin, *output_size);
 }
 /////////////////////////
 /////////////////////////
@@ -114,11 +372,31 @@ void compress_text(unsigned char *input_txt, const uint32_t max_size, unsigned
 /// Text Decompressors  ///
 ///////////////////////////
 /*
-The function decompresses `input_txt` using the LZRW3a algorithm,  
+The function adds a stored text of COMPRESS_MIN or more bytes to the 
+history of received messages. The compressor of the other side has 
+compressed it before it chose to store it, so the text is compressed 
+here too(output is dropped) to keep the hash tables in step.
+*/
+static void compress_resync(struct compress_ctx *ctx, const uint8_t *text, const uint32_t size)
+{
+ uint8_t scratch[COMPRESS_BOUND(BUFF_MAX)];
+ uint32_t scratch_size = 0;
+ compress_slide(ctx->backend, ctx->rx_table, ctx->rx_history, &ctx->rx_used);
+ memcpy(ctx->rx_history + ctx->rx_used, text, size);
+ ctx->backend->compress(ctx->rx_table, ctx->rx_history + ctx->rx_used, size, scratch, &scratch_size, ctx->rx_used);
+ ctx->rx_used += size;
+ memset(scratch, 0, sizeof(scratch)); // Compressed form of the text
+}
+
+/*
+The function decompresses `input_txt` using the backend of `ctx`,  
 and the decompressed text is written to `output_txt`. 
+Stored messages(COMPRESS_STORED header) are only copied.
 This function takes the following parameters:  
+- `ctx` - compression context(compress_init()) with the work memory.  
 - `input_txt` - the compressed text to be decompressed.  
-- `max_size` - the maximum size that the decompressed text can have.  
+- `max_size` - the size of `output_txt`(TEXT_MAX in receive_message()), 
+  a longer text is not written and the program exits.  
 - `input_size` - the size of the compressed text.  
 - `output_txt` - a pointer to the buffer where the decompressed 
   text will be stored.  
@@ -126,33 +404,57 @@ This function takes the following parameters:
 For more information on LZRW3a, see:  
 LZRW3-A: http://www.ross.net/compression/lzrw3a.html
 */
-void decompress_text(unsigned char *input_txt, const uint32_t max_size, unsigned char *output_txt, const uint32_t input_size)
+void decompress_text(struct compress_ctx *ctx, unsigned char *input_txt, const uint32_t max_size, unsigned char *output_txt, const uint32_t input_size)
 {
+ TRACE_BEGIN(trace_begin);
  /*Output size*/
  uint32_t output_size = 0; 
- /*
-  Working memory for LZRW3a compression.
-  The allocation type is determined based on the ALLOCATION flag.
- */
- #if ALLOCATION == DYNAMIC // Check parameters.h for more info about macros 
-   /* Dynamic memory allocation */
-   void *wrk_mem = ALLOCATE_WORK_AREA(lzrw3a_req_mem()); 
-   if (wrk_mem == NULL) {
-       exit_with_error(ALLOCATION_ERROR, "Memory allocation failed");
-   }
- #elif ALLOCATION == STATIC_BSS
-   static uint8_t wrk_mem[MEM_REQ]; // Static memory allocation on BSS segment
- #else
-     uint8_t wrk_mem[MEM_REQ]; // Static memory allocation on STACK segment
- #endif
+ uint8_t *dst = output_txt;
+ uint32_t history = 0;
+ /*The backend stops at the end of the output(a broken frame can not overflow it)*/
+ uint32_t capacity = max_size < BUFF_MAX ? max_size : BUFF_MAX;
 
- /*LZRW3a decompress*/
- lzrw3a_compress(COMPRESS_ACTION_DECOMPRESS,wrk_mem,input_txt,input_size,output_txt,&output_size); 
- FREE_WORK_AREA(wrk_mem);
+ if (input_size < COMPRESS_HEADER) {
+    exit_with_error(TEXT_OVERFLOW, "Compressed text size is bigger than buffer");
+ }
+ /*Stored text is only copied, bounded by the output like the backend*/
+ if (input_txt[0] == COMPRESS_STORED) {
+    output_size = input_size - COMPRESS_HEADER;
+    if (output_size > capacity) {
+       exit_with_error(TEXT_OVERFLOW, "Compressed text size is bigger than buffer");
+    }
+    memcpy(output_txt, input_txt + COMPRESS_HEADER, output_size);
+    if (ctx->stream == YES && output_size >= COMPRESS_MIN) {
+       compress_resync(ctx, output_txt, output_size);
+    }
+    TRACE_END(TRACE_DECOMPRESS, trace_begin, input_size);
+    return;
+ }
 
- if (output_size>max_size) {
+ if (ctx->stream == YES) {
+    /*Text is decompressed right after the history of received messages*/
+    compress_slide(ctx->backend, ctx->rx_table, ctx->rx_history, &ctx->rx_used);
+    dst = ctx->rx_history + ctx->rx_used;
+    history = ctx->rx_used;
+    /*Room left in the history, checked before anything is written*/
+    if (COMPRESS_HISTORY_MEM - ctx->rx_used < capacity) {
+       capacity = COMPRESS_HISTORY_MEM - ctx->rx_used;
+    }
+ }
+ else {
+    compress_start(ctx, ctx->rx_table);
+ }
+ ctx->backend->decompress(ctx->rx_table, input_txt, input_size, dst, capacity, &output_size, history);
+
+ /*UINT32_MAX: broken frame or the text does not fit*/
+ if (output_size > capacity) {
    exit_with_error(TEXT_OVERFLOW, "Compressed text size is bigger than buffer");
  }
+ if (dst != output_txt) {
+    memcpy(output_txt, dst, output_size);
+    ctx->rx_used += output_size;
+ }
+ TRACE_END(TRACE_DECOMPRESS, trace_begin, input_size);
 }
 ///////////////////////////
-///////////////////////////
\ No newline at end of file
+///////////////////////////
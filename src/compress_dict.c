@@ -0,0 +1,42 @@
+// Client-server API(PICO)        //
+// Compression dictionary         //
+// Version 0.9.1pi                //
+// Bachelor's Work Project        //
+// Technical University of Kosice //
+// 17.10.2026                     //
+// Nikita Kuropatkin              //
+// Version for MCU                //
+// W5100S-EVB-Pico                //
+
+/*
+Generated by dict_build(bench/dict_build.c) from chat_corpus.txt, do not edit.
+Constant data stays in flash(XIP on RP2040), see compress_dict.h.
+*/
+#include <stdint.h>
+#include "include/compress_dict.h"
+
+const uint32_t compress_dict_size = 1024;
+
+const uint8_t compress_dict[1024 + COMPRESS_DICT_PAD] =
+ "erver room valve 5\n"
+ "get voltage east tower\n"
+ " room humidity 93, level 16, allaffirmative\n"
+ "copy that\n"
+ "alarm control room: current highget flow north gate\n"
+ "tatus substation B: voltage 54.6alarm server room: humidity high"
+ "rator anna on shift at relay 7 f shift at north gate from 18:00\n"
+ "eport: dock 1 temp 47, voltage 1set lab 3 humidity limirepeat pl"
+ "ease\n"
+ "ort: substation B level 74, humi: temp high (103), please check\n"
+ "status tank farm: flow 50.1 nomistatus dock 1: flow 48.3 nomiock"
+ " 1 pressure 23, temp 20, all tatus east tower: flow 52.8 nomista"
+ "tus relay 7: temp 51.5 nomistatus server room: voltage 4reset pu"
+ "mp station 2 breaker 8\n"
+ "s nominal, next check in 57 min\n"
+ "operator peter on shift at dockstatus north gate: pressure 6alar"
+ "m dock 1: level high (104), reset tank farm valve report: contro"
+ "l room temp 19, alarm substation B: flow high (2s relay 7: curre"
+ "nt 64.0 nominal\n"
+ "a on shift at server room from 1set east tower voltage limit to "
+ "pressure high (199), please checstatus pump station 2: humidity "
+ " all systems nominal, next check";
@@ -13,6 +13,17 @@
 #include "include/error.h"
 #include "hardware/watchdog.h"
 #include "include/parameters.h" // Macros are defined here
+#include "include/client/pin.h" //pin_cache_wipe()
+#include "include/compress_decompress.h" //compress_abort()
+#include "include/core1.h" //core_error()
+
+/*
+Recovery point of transport errors(see error.h), 
+its state and the number of recovered errors in a row.
+*/
+jmp_buf error_recovery;
+static int recovery_armed = NO;
+static int recovery_count = 0;
 
 ///////////////////////////////////////
 /// Error Printing and System Reset ///
@@ -31,6 +42,10 @@ software reset method for the W5100S-EVB-Pico board.
 - `err_string`: A string that contains details about the error.
 
 #Behavior:
+0. If the error is a transport error(error_class()) and recovery point is
+   armed, the error is printed(DEBUG) and the program continues from the
+   recovery point in main() without reboot(at most RECONNECT_COUNT times
+   in a row).
 1. If the `DEBUG` macro is set to `YES`:
    - The function prints the error details to the terminal.
    - Prompts the user to press Enter before resetting.
@@ -41,8 +56,28 @@ software reset method for the W5100S-EVB-Pico board.
 #Notes:
 - This function is specific to the W5100S-EVB-Pico board and uses the 
   watchdog timer for resets.
+- Core1 must not wipe or free memory which core0 may be using, so on 
+  core1 the error is handed over to core0 by core_error() and core1 
+  stops. Only core0 prints, reconnects and reboots.
 */
 void exit_with_error(const int error, const char *err_string) {
+ if (get_core_num() != 0) {
+    core_error(error, err_string); // Core0 reports it, does not return
+ }
+ pin_cache_wipe(); // Unlocked key is not kept after any error
+ compress_abort(); // Work memory of chat() is not lost by reconnect
+
+ if (recovery_armed == YES && error_class(error) == ERROR_CLASS_TRANSPORT &&
+     recovery_count < RECONNECT_COUNT) {
+   recovery_armed = NO;
+   recovery_count++;
+   if (DEBUG == YES) {
+      printf("\n!Connection error!\n%s, reconnecting(%d/%d)...\n", 
+             err_string, recovery_count, RECONNECT_COUNT);
+   }
+   longjmp(error_recovery, error); // Back to main(), no reboot
+ }
+
  if (DEBUG == YES) {
    if (error != OK) {
       printf("\n!Error occurred!\n");
@@ -63,3 +98,45 @@ void exit_with_error(const int error, const char *err_string) {
  // Infinite loop to wait for the watchdog timer to reset the system
  while (1);
 }
+///////////////////////////////////////
+///////////////////////////////////////
+
+///////////////////////////////////////
+/// Error Classes and Recovery      ///
+///////////////////////////////////////
+/*
+Returns the class of the error code `error`(ERROR_CLASS_*).
+Only failures of the connection are transport errors, integrity 
+(MESSAGE_ALTERED, UNEQUAL_MAC) and entropy(ERROR_GENERATING_RANDOM,
+ERROR_SEEDING_XDRBG) failures always reboot the chip.
+*/
+int error_class(const int error) {
+ switch (error) {
+   case ERROR_SOCKET_CREATION:
+   case ERROR_RECEIVING_DATA:
+   case ERROR_SENDING_DATA:
+   case ERROR_CLIENT_CONNECTION:
+   case DHCP_ERROR:
+      return ERROR_CLASS_TRANSPORT;
+   default:
+      return ERROR_CLASS_FATAL;
+ }
+}
+
+/*
+Enables the recovery point(error_recovery must be set by setjmp).
+*/
+void recovery_arm(void) {
+ recovery_armed = YES;
+}
+
+/*
+Disables the recovery point, after successful session also resets 
+the counter of recovered errors(`success` is YES).
+*/
+void recovery_disarm(const int success) {
+ recovery_armed = NO;
+ if (success == YES) recovery_count = 0;
+}
+///////////////////////////////////////
+///////////////////////////////////////
@@ -0,0 +1,163 @@
+// Client-server API(PICO)        //
+// Second core worker             //
+// Version 0.9.1pi                //
+// Bachelor's Work Project        //
+// Technical University of Kosice //
+// 17.10.2026                     //
+// Nikita Kuropatkin              //
+// Version for MCU                //
+// W5100S-EVB-Pico                //
+
+#include <stddef.h>
+#include <stdint.h>
+#include "include/core1.h"
+#include "include/keypool.h"
+#include "include/error.h"
+#include "include/parameters.h" //Macros are defined here
+#include "pico/multicore.h"
+#include "pico/flash.h"
+#include "hardware/sync.h"
+
+#if ALLOCATION == STATIC_STACK && CORE1_STACK_SIZE < BLOCK_AMOUNT * 1024 + 4096
+  #error "CORE1_STACK_SIZE is too small for Argon2i work area on the stack"
+#endif
+
+/*
+Job submitted by core0, NULL when core1 is free.
+Only core0 sets it, only core1 clears it after the job returns.
+*/
+static void (*volatile core1_job)(void) = NULL;
+static int core1_running = NO;
+
+/*
+Error of core1(OK if none) and its message, set by core_error() on 
+core1 and reported by core0 in core1_check().
+*/
+static volatile int core1_error = OK;
+static const char *volatile core1_error_string = NULL;
+
+/*
+Stack of core1.
+*/
+static uint32_t core1_stack[CORE1_STACK_SIZE / sizeof(uint32_t)];
+
+/////////////////////////
+///    Core1 worker   ///
+/////////////////////////
+/*
+Main loop of core1: runs the submitted job, otherwise fills one entry
+of the keypair pool, sleeps(WFE) if there is nothing to do.
+*/
+static void core1_main(void)
+{
+ /*Core0 must be able to stop this core while it writes to flash*/
+ flash_safe_execute_core_init();
+
+ while (1) {
+    void (*job)(void) = core1_job;
+    if (job != NULL) {
+       __dmb(); // Inputs of the job are read after the job was published
+       job();
+       __dmb(); // Results are written before the job is marked as done
+       core1_job = NULL;
+       __sev(); // Wake up core0 in core1_wait()
+    }
+    else if (keypool_fill() == NO) {
+       __wfe();
+    }
+ }
+}
+/////////////////////////
+/////////////////////////
+
+/////////////////////////
+///   Core0 interface ///
+/////////////////////////
+/*
+Launches the worker on core1. Later calls do nothing.
+keypool_start() must be called first.
+*/
+void core1_start(void)
+{
+ if (core1_running == YES) {
+    return;
+ }
+ multicore_launch_core1_with_stack(core1_main, core1_stack, sizeof(core1_stack));
+ core1_running = YES;
+}
+
+/*
+Hands `job` over to core1, waits first if the previous job still runs.
+Parameters:
+- `job`: Function that core1 runs once.
+*/
+void core1_submit(void (*job)(void))
+{
+ core1_wait();
+ __dmb(); // Inputs of the job are written before it is published
+ core1_job = job;
+ __sev(); // Wake up core1
+}
+
+/*
+Returns YES while a submitted job is not finished, otherwise NO.
+*/
+int core1_busy(void)
+{
+ return (core1_job != NULL) ? YES : NO;
+}
+
+/*
+Waits until the submitted job is finished(returns at once if there
+is no job). After return, data written by the job are visible.
+*/
+void core1_wait(void)
+{
+ while (core1_job != NULL && core1_error == OK) {
+    __wfe();
+ }
+ __dmb();
+ core1_check();
+}
+
+/*
+Reports the error of core1 on core0(exit_with_error()), if core1 has
+stopped with one, otherwise returns.
+*/
+void core1_check(void)
+{
+ if (core1_error != OK) {
+    __dmb(); // Message is read after the error code
+    exit_with_error(core1_error, core1_error_string);
+ }
+}
+/////////////////////////
+/////////////////////////
+
+/////////////////////////
+///   Both cores      ///
+/////////////////////////
+/*
+Handles an error on any core. On core0 it is exit_with_error(). Core1 
+must not run it(it wipes and frees memory core0 is using and may wait 
+for Enter), so the error is handed over to core0(core1_check()) and 
+core1 stops until the reboot.
+Parameters:
+- `error`: An error code defined in `error.h`.
+- `err_string`: A string that contains details about the error.
+*/
+void core_error(const int error, const char *err_string)
+{
+ if (get_core_num() == 0) {
+    exit_with_error(error, err_string);
+ }
+ core1_error_string = err_string;
+ __dmb(); // Message is written before the error code
+ core1_error = error;
+ __sev(); // Wake up core0 in core1_wait()
+ while (1) {
+    __wfe();
+ }
+}
+/////////////////////////
+/////////////////////////
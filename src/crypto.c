@@ -10,67 +10,129 @@
 
 #include <string.h>
 #include <stdio.h>
-#include <math.h>
 #include "include/crypto.h" //Crypto primitievs
 #include "include/monocypher.h"
 #include "include/random.h" //CSPRNG
 #include "include/error.h"
 #include "include/parameters.h" //Macros are defined here
+#include "include/trace.h"
+#include "include/compress_decompress.h" //to_byte_array()
 
 /*
-Macros for PADME:
-- L16, L24, L32: Sizes of messages (compared to input size).
-- S16, S24, S32: Computation of the S element for the PADME 
-  algorithm for different sizes.
-- E16, E24, E32: Computation of the E element for the PADME 
-  algorithm for different sizes.
-These macros ensure that the log2 calculations are executed at compile time, 
-making the code more lightweight for embedded platforms.
+Sizes of the padded key, nonce and MAC are part of the protocol(server
+computes the same ones), PADME_SIZE() must keep them.
 */
-#define L16 16
-#define E16 (int)log2(L16)
-#define S16 (int)log2(E16) + 1
-
-#define L24 24
-#define E24 (int)log2(L24)
-#define S24 (int)log2(E24) + 1
-
-#define L32 32
-#define E32 (int)log2(L32)
-#define S32 (int)log2(E32) + 1
+_Static_assert(PADME_SIZE(16) == 17 && PADME_SIZE(24) == 25 && PADME_SIZE(32) == 35,
+               "PADME sizes of MAC, nonce and key changed");
 
 /////////////////
 ///   PADME   ///
 /////////////////
+/*
+Floor of log2(`x`) by counting leading zeros(0 for `x` = 0).
+*/
+static int padme_log2(const uint32_t x) {
+ return (x == 0) ? 0 : 31 - __builtin_clz(x);
+}
+
+/*
+Returns the PADME bitmask of the size `L`: E = log2(L), S = log2(E) + 1,
+the lowest E - S bits of the padded size are zero(no mask if E - S < 1).
+*/
+static int padme_mask(const int L) {
+ int E = padme_log2((uint32_t)L);
+ int S = padme_log2((uint32_t)E) + 1;
+ return (E > S) ? (1 << (E - S)) - 1 : 0;
+}
+
 /*
 This function derives the size of the padded array from the original
 message size. It implements the PADME algorithm without rounding
-using a bitmask (PADME: https://lbarman.ch/blog/padme/).
+using a bitmask (PADME: https://lbarman.ch/blog/padme/), for sizes
+known at compile time use PADME_SIZE().
 Parameters:
-- `L`: The size of the original message (L16, L24, or L32).
+- `L`: The size of the original message(any size from 1).
 Returns:
 - The size of the padded message.
 */
 int padme_size(const int L) {
  //modified PADME for padding of the key + nonce
- int E;
- int S;
- if (L == L16) {
-   E = E16;
-   S = S16;
+ if (L < 1) {
+   exit_with_error(UNSUPPORTED_SIZE, "Unsupported size for padding"); 
  }
- else if (L == L24) {
-   E = E24;
-   S = S24;
+ return (L + padme_mask(L));
+}
+
+/*
+This function rounds the size `L` up by the PADME algorithm, so only
+O(log log L) bits of the size are leaked(lengths of cipher text), 
+for sizes known at compile time use PADME_ROUND().
+Parameters:
+- `L`: The size of the original message(any size from 1).
+Returns:
+- The size of the padded message.
+*/
+int padme_round(const int L) {
+ if (L < 1) {
+   exit_with_error(UNSUPPORTED_SIZE, "Unsupported size for padding"); 
  }
- else if (L == L32) {
-   E = E32;
-   S = S32;
+ int mask = padme_mask(L);
+ return (L + mask) & ~mask;
+}
+
+/*
+This function pads a compressed message before encryption
+(MESSAGE_PADDING in parameters.h). It writes the size of the text
+in front of it and zeros after it up to padme_round() of the whole
+message. Without padding the message stays unchanged.
+Parameters:
+- `message`: Buffer of MESSAGE_MAX bytes, the text is at MESSAGE_OFFSET.
+- `size`: Size of the text(up to BUFF_MAX).
+Returns:
+- The size of the padded message.
+*/
+uint32_t pad_message(uint8_t *message, const uint32_t size)
+{
+ if (size > BUFF_MAX) {
+   exit_with_error(TEXT_OVERFLOW, "Message is bigger than buffer");
  }
- else exit_with_error(UNSUPPORTED_SIZE, "Unsupported size for padding"); 
- int lastBits = E - S;
- int bitMask = (1 << lastBits) - 1;
- return (L + bitMask);
+ if (MESSAGE_PADDING != YES) {
+   return size;
+ }
+ uint32_t padded_size = (uint32_t)padme_round(MESSAGE_OFFSET + (int)size);
+ to_byte_array(size, message);
+ /*Zeros are encrypted in place with the text, so on the wire they are key stream*/
+ memset(message + MESSAGE_OFFSET + size, 0, padded_size - MESSAGE_OFFSET - size);
+ return padded_size;
+}
+
+/*
+Reverse of pad_message function, reads the size of the text from
+a decrypted message. The text stays at MESSAGE_OFFSET.
+Parameters:
+- `message`: Decrypted padded message.
+- `padded_size`: Size of the padded message.
+- `size`: Pointer where the size of the text will be stored.
+Returns:
+- OK if the size fits BUFF_MAX and the padding matches it,
+  otherwise RETURN_ERROR.
+*/
+int unpad_message(const uint8_t *message, const uint32_t padded_size, uint32_t *size)
+{
+ if (MESSAGE_PADDING != YES) {
+   *size = padded_size;
+   return (padded_size > BUFF_MAX) ? RETURN_ERROR : OK;
+ }
+ if (padded_size < MESSAGE_OFFSET || padded_size > MESSAGE_MAX) {
+   return RETURN_ERROR;
+ }
+ *size = from_byte_array(message, 0);
+ /*Only the size produced by pad_message() is accepted*/
+ if (*size > BUFF_MAX || (uint32_t)padme_round(MESSAGE_OFFSET + (int)*size) != padded_size) {
+   *size = 0;
+   return RETURN_ERROR;
+ }
+ return OK;
 }
 
 /*
@@ -119,6 +181,7 @@ Parameters:
 */
 void kdf(uint8_t *shared_key, const uint8_t *your_sk, const uint8_t *your_pk, const uint8_t *their_pk, const int keysz)
 {
+ TRACE_BEGIN(trace_begin);
  uint8_t shared_secret[keysz]; // Raw shared key
  
  // Compute shared secret
@@ -134,6 +197,7 @@ void kdf(uint8_t *shared_key, const uint8_t *your_sk, const uint8_t *your_pk, co
         
  // Cleaning raw shared secret
  crypto_wipe(shared_secret, keysz);
+ TRACE_END(TRACE_KDF, trace_begin, keysz);
 }
 ///////////////////////////////
 ///////////////////////////////
@@ -160,6 +224,8 @@ Parameters:
 - `keysz`: The size of the keys (both SK and PK).
 */
 void key_hidden(uint8_t *your_sk, uint8_t *your_pk, uint8_t *hidden, const int keysz) {
+ TRACE_BEGIN(trace_begin);
+ uint32_t rejections = 0; // Count of PKs without Elligator representative
  uint8_t tweak; // Tweak for elligator`s inverse map
  random_num(&tweak, 1); // Tweak generation
 
@@ -172,7 +238,100 @@ void key_hidden(uint8_t *your_sk, uint8_t *your_pk, uint8_t *hidden, const int k
  crypto_x25519_dirty_fast(your_pk, your_sk);
  if (crypto_elligator_rev(hidden, your_pk, tweak) == OK)
     break;
+ rejections++;
  }
+ TRACE_END(TRACE_KEY_HIDDEN, trace_begin, rejections);
+ (void)rejections; // Unused when TRACE is NO
 }
 /////////////////////////////////////////
-/////////////////////////////////////////
\ No newline at end of file
+/////////////////////////////////////////
+
+/////////////////////////////////
+///   Streamed AEAD reading   ///
+/////////////////////////////////
+/*
+Size of the ChaCha20 block and of the Poly1305 block.
+*/
+#define CHACHA_BLOCK 64
+#define POLY_BLOCK 16
+
+#if AEAD_CHUNK % CHACHA_BLOCK != 0
+  #error "AEAD_CHUNK must be a multiple of 64"
+#endif
+
+/*
+Starts decryption of one AEAD message that arrives in chunks.
+It computes the one-time Poly1305 key from the AEAD state `ctx` exactly
+like crypto_aead_read() does(no additional data is used).
+Parameters:
+- `stream`: A pointer to the state of the streamed message.
+- `ctx`: A pointer to the AEAD state(not changed until aead_read_final()).
+*/
+void aead_read_init(struct aead_stream *stream, const crypto_aead_ctx *ctx)
+{
+ /*First block of the keystream: Poly1305 key + key for rekeying*/
+ crypto_chacha20_djb(stream->auth_key, NULL, CHACHA_BLOCK, ctx->key, ctx->nonce, ctx->counter);
+ crypto_poly1305_init(&stream->poly, stream->auth_key);
+ stream->counter = ctx->counter + 1; // Text starts at the second block
+ stream->text_size = 0;
+}
+
+/*
+Authenticates and decrypts the next chunk of the streamed message.
+Every chunk except the last one must be a multiple of 64 bytes(ChaCha20
+block), so the block counter continues without keeping the keystream.
+The plain text is written before the MAC is verified, so the caller must
+not use(and should wipe) it when aead_read_final() fails.
+Parameters:
+- `stream`: A pointer to the state of the streamed message.
+- `ctx`: A pointer to the AEAD state.
+- `plain_text`: A pointer to the buffer for decrypted chunk.
+- `cipher_text`: A pointer to the received chunk.
+- `size`: The size of the chunk.
+*/
+void aead_read_update(struct aead_stream *stream, const crypto_aead_ctx *ctx, uint8_t *plain_text, const uint8_t *cipher_text, const size_t size)
+{
+ /*Previous chunk was not a whole number of blocks, it had to be the last*/
+ if (stream->text_size % CHACHA_BLOCK != 0) {
+    exit_with_error(UNSUPPORTED_SIZE, "Only the last AEAD chunk can be partial");
+ }
+ crypto_poly1305_update(&stream->poly, cipher_text, size);
+ stream->counter = crypto_chacha20_djb(plain_text, cipher_text, size, ctx->key, ctx->nonce, stream->counter);
+ stream->text_size += size;
+}
+
+/*
+Finishes the streamed message: compares the MAC with `mac` in constant time
+and on success re-keys the AEAD state `ctx` as crypto_aead_read() does.
+Parameters:
+- `stream`: A pointer to the state of the streamed message(wiped).
+- `ctx`: A pointer to the AEAD state.
+- `mac`: The received MAC of the message.
+Returns:
+- OK if the message is authentic, RETURN_ERROR otherwise.
+*/
+int aead_read_final(struct aead_stream *stream, crypto_aead_ctx *ctx, const uint8_t mac[16])
+{
+ static const uint8_t zero[POLY_BLOCK] = {0};
+ uint8_t sizes[POLY_BLOCK] = {0}; // Sizes of AD(0) and text, little endian
+ uint8_t real_mac[MACSZ]; // MAC computed from the received cipher text
+
+ for (int i = 0; i < 8; i++) {
+    sizes[8 + i] = (uint8_t)((uint64_t)stream->text_size >> (8 * i));
+ }
+ /*Same layout as in Monocypher: text, zero padding to 16 bytes, sizes*/
+ crypto_poly1305_update(&stream->poly, zero, (POLY_BLOCK - stream->text_size % POLY_BLOCK) % POLY_BLOCK);
+ crypto_poly1305_update(&stream->poly, sizes, POLY_BLOCK);
+ crypto_poly1305_final(&stream->poly, real_mac);
+
+ int result = RETURN_ERROR;
+ if (crypto_verify16(mac, real_mac) == OK) {
+    memcpy(ctx->key, stream->auth_key + KEYSZ, KEYSZ); // Rekeying
+    result = OK;
+ }
+ crypto_wipe(stream, sizeof(*stream));
+ crypto_wipe(real_mac, MACSZ);
+ return result;
+}
+/////////////////////////////////
+/////////////////////////////////
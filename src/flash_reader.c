@@ -13,6 +13,9 @@
 #include <stdlib.h>
 #include "include/error.h" //All errors defined + function proto
 #include "include/parameters.h"
+#include "include/monocypher.h" //crypto_wipe()
+#include "hardware/flash.h"
+#include "pico/flash.h"
 
 /*
 A pointer to the memory address of the specified flash page,  
@@ -42,3 +45,60 @@ void read_from_flash(const int offset, uint8_t *buffer, const int size) {
 }
 ///////////////////////
 ///////////////////////
+
+////////////////////////
+/// Flash Mem Writer ///
+////////////////////////
+/*
+Erases the sector of FLASH_PAGE(key page) when it is safe to do so.
+Takes as input parameter:
+  - param: Not used, the sector is always FLASH_PAGE.
+*/
+static void call_key_page_erase(void *param) {
+ (void)param;
+ flash_range_erase(FLASH_PAGE, FLASH_SECTOR_SIZE);
+}
+
+/*
+Programs the first FLASH_PAGE_SIZE bytes of FLASH_PAGE when it is safe
+to do so.
+Takes as input parameter:
+  - param: A pointer to FLASH_PAGE_SIZE bytes of data.
+*/
+static void call_key_page_program(void *param) {
+ flash_range_program(FLASH_PAGE, (const uint8_t *)param, FLASH_PAGE_SIZE);
+}
+
+/*
+Replaces `size` bytes of the key page at `offset`, other bytes of the
+first FLASH_PAGE_SIZE bytes(key, salt, Argon2i parameters) are kept.
+The whole sector is erased, so nothing else may be stored in it.
+The sector is erased and then programmed in place, there is no second 
+copy: if the power is lost between the two steps, the secured key, 
+salt and Argon2i parameters are lost and the key must be written again.
+
+Parameters:  
+- `offset` - the starting position in the key page, 
+  `offset` + `size` must not exceed FLASH_PAGE_SIZE.
+- `buffer` - the data to write.  
+- `size` - the number of bytes to write.  
+*/
+void write_to_flash(const int offset, const uint8_t *buffer, const int size) {
+ uint8_t page[FLASH_PAGE_SIZE];
+ read_from_flash(0, page, FLASH_PAGE_SIZE); // Current key page
+ for (int i = offset, j = 0; i < offset + size; i++, j++) {
+  page[i] = buffer[j];
+ }
+
+ if (flash_safe_execute(call_key_page_erase, NULL, UINT32_MAX) != PICO_OK) {
+  crypto_wipe(page, FLASH_PAGE_SIZE);
+  exit_with_error(ERROR_FLASH, "Error erasing flash");
+ }
+ if (flash_safe_execute(call_key_page_program, page, UINT32_MAX) != PICO_OK) {
+  crypto_wipe(page, FLASH_PAGE_SIZE);
+  exit_with_error(ERROR_FLASH, "Error programming flash");
+ }
+ crypto_wipe(page, FLASH_PAGE_SIZE); // Copy of the secured key is not left on stack
+}
+///////////////////////
+///////////////////////
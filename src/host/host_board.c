@@ -0,0 +1,433 @@
+// Client-server API(PICO)        //
+// Host HAL: board and W5100S     //
+// Version 0.9.1pi                //
+// Bachelor's Work Project        //
+// Technical University of Kosice //
+// 17.10.2026                     //
+// Nikita Kuropatkin              //
+// Host emulation of              //
+// W5100S-EVB-Pico                //
+
+/*
+Emulation of the W5100S-EVB-Pico board for the Linux host build:
+clocks, UART(stdin/stdout), watchdog, 1 ms timer, second core, 
+W5100S initialization, DHCP client and entropy source for XDRBG seeding.
+*/
+#include <errno.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/random.h>
+#include "port_common.h"
+#include "timer.h"
+#include "dhcp.h"
+#include "w5x00_spi.h"
+#include "hardware/watchdog.h"
+#include "hardware/sync.h"
+#include "pico/multicore.h"
+#include "random_entropy.h"
+
+///////////////////////
+/// Clocks and sleep ///
+///////////////////////
+/*
+There is no PLL on host, the process runs at the speed of the CPU.
+*/
+bool set_sys_clock_khz(uint32_t freq_khz, bool required)
+{
+ (void)freq_khz;
+ (void)required;
+ return true;
+}
+
+bool clock_configure(enum clock_index clk_index, uint32_t src, uint32_t auxsrc, uint32_t src_freq, uint32_t freq)
+{
+ (void)clk_index;
+ (void)src;
+ (void)auxsrc;
+ (void)src_freq;
+ (void)freq;
+ return true;
+}
+
+/*
+Sleeps for `ms` milliseconds(restarted if interrupted by a signal).
+*/
+void sleep_ms(uint32_t ms)
+{
+ struct timespec left = { ms / 1000, (long)(ms % 1000) * 1000000L };
+ while (nanosleep(&left, &left) != 0 && errno == EINTR);
+}
+
+/*
+Sleeps for `us` microseconds(restarted if interrupted by a signal).
+*/
+void sleep_us(uint64_t us)
+{
+ struct timespec left = { (time_t)(us / 1000000u), (long)(us % 1000000u) * 1000L };
+ while (nanosleep(&left, &left) != 0 && errno == EINTR);
+}
+
+/*
+Free-running microsecond timer(CLOCK_MONOTONIC relative to the first call).
+*/
+uint64_t time_us_64(void)
+{
+ static uint64_t boot_us = 0;
+ struct timespec ts;
+ clock_gettime(CLOCK_MONOTONIC, &ts);
+ uint64_t now_us = (uint64_t)ts.tv_sec * 1000000u + (uint64_t)ts.tv_nsec / 1000u;
+ if (boot_us == 0) boot_us = now_us;
+ return now_us - boot_us;
+}
+
+uint32_t time_us_32(void)
+{
+ return (uint32_t)time_us_64();
+}
+
+void wiz_delay_ms(uint32_t ms)
+{
+ sleep_ms(ms);
+}
+
+void wizchip_delay_ms(uint32_t ms)
+{
+ sleep_ms(ms);
+}
+
+///////////////////////
+/// UART(stdio)     ///
+///////////////////////
+/*
+Flag of the emulated UART: set when the line on stdin was consumed.
+*/
+static bool uart_line_done = false;
+
+bool stdio_uart_init(void)
+{
+ setvbuf(stdout, NULL, _IONBF, 0); // UART has no output buffering
+ /*No input buffering either, so poll() in getchar_timeout_us() is exact*/
+ setvbuf(stdin, NULL, _IONBF, 0);
+ return true;
+}
+
+bool stdio_usb_init(void)
+{
+ return stdio_uart_init();
+}
+
+void gpio_set_function(unsigned int gpio, unsigned int fn)
+{
+ (void)gpio;
+ (void)fn;
+}
+
+void uart_set_fifo_enabled(uart_inst_t *uart, bool enabled)
+{
+ (void)uart;
+ (void)enabled;
+}
+
+void uart_set_hw_flow(uart_inst_t *uart, bool cts, bool rts)
+{
+ (void)uart;
+ (void)cts;
+ (void)rts;
+}
+
+void uart_puts(uart_inst_t *uart, const char *s)
+{
+ (void)uart;
+ fputs(s, stdout);
+ fflush(stdout);
+}
+
+/*
+Input is readable until the end of the current line was consumed,
+after that one "not readable" answer re-arms the flag for the next line.
+*/
+bool uart_is_readable(uart_inst_t *uart)
+{
+ (void)uart;
+ if (uart_line_done) {
+    uart_line_done = false;
+    return false;
+ }
+ return true;
+}
+
+char uart_getc(uart_inst_t *uart)
+{
+ (void)uart;
+ int c = getchar();
+ if (c == '\n' || c == EOF) uart_line_done = true;
+ return (char)c;
+}
+
+int getchar_timeout_us(uint32_t timeout_us)
+{
+ struct pollfd input = { .fd = 0, .events = POLLIN, .revents = 0 };
+ int timeout_ms = (int)((timeout_us + 999) / 1000);
+ if (poll(&input, 1, timeout_ms) <= 0) return PICO_ERROR_TIMEOUT;
+ int c = getchar();
+ return (c == EOF) ? PICO_ERROR_GENERIC : c;
+}
+
+///////////////////////
+/// Watchdog        ///
+///////////////////////
+/*
+Ends the process instead of rebooting the chip, so benchmarks and
+valgrind see a normal exit. Error path uses delayed reboot.
+*/
+void watchdog_reboot(uint32_t pc, uint32_t sp, uint32_t delay_ms)
+{
+ (void)pc;
+ (void)sp;
+ fflush(stdout);
+ exit(delay_ms == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
+///////////////////////
+/// 1 ms timer      ///
+///////////////////////
+/*
+Thread that calls `arg`(timer callback) every millisecond,
+wake-ups are planned on absolute time so the counter does not drift.
+*/
+static void *host_timer_thread(void *arg)
+{
+ void (*callback)(void) = (void (*)(void))arg;
+ struct timespec next;
+ clock_gettime(CLOCK_MONOTONIC, &next);
+ while (1) {
+    next.tv_nsec += 1000000L;
+    if (next.tv_nsec >= 1000000000L) {
+       next.tv_nsec -= 1000000000L;
+       next.tv_sec++;
+    }
+    clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, NULL);
+    callback();
+ }
+ return NULL;
+}
+
+void wizchip_1ms_timer_initialize(void (*callback)(void))
+{
+ pthread_t thread;
+ if (pthread_create(&thread, NULL, host_timer_thread, (void *)callback) == 0) {
+    pthread_detach(thread);
+ }
+}
+
+///////////////////////
+/// Second core     ///
+///////////////////////
+/*
+Event registers of the cores for SEV/WFE, core number is kept per thread
+(core1 is the thread started by multicore_launch_core1_with_stack()).
+*/
+static pthread_mutex_t host_event_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t host_event_cond = PTHREAD_COND_INITIALIZER;
+static int host_event[2] = {0, 0};
+static __thread int host_core = 0;
+
+/*
+Thread that runs the entry function of core1.
+*/
+static void *host_core1_thread(void *arg)
+{
+ void (*entry)(void) = (void (*)(void))arg;
+ host_core = 1;
+ entry();
+ return NULL;
+}
+
+unsigned int get_core_num(void)
+{
+ return (unsigned int)host_core;
+}
+
+void multicore_launch_core1_with_stack(void (*entry)(void), uint32_t *stack_bottom, size_t stack_size_bytes)
+{
+ (void)stack_bottom;
+ (void)stack_size_bytes;
+ pthread_t thread;
+ if (pthread_create(&thread, NULL, host_core1_thread, (void *)entry) == 0) {
+    pthread_detach(thread);
+ }
+}
+
+void __dmb(void)
+{
+ __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+/*
+SEV sets event registers of both cores.
+*/
+void __sev(void)
+{
+ pthread_mutex_lock(&host_event_mutex);
+ host_event[0] = 1;
+ host_event[1] = 1;
+ pthread_cond_broadcast(&host_event_cond);
+ pthread_mutex_unlock(&host_event_mutex);
+}
+
+/*
+WFE waits for the event of this core(at most 1 ms, like a spurious
+wake-up on the chip) and clears it.
+*/
+void __wfe(void)
+{
+ pthread_mutex_lock(&host_event_mutex);
+ if (host_event[host_core] == 0) {
+    struct timespec until;
+    clock_gettime(CLOCK_REALTIME, &until);
+    until.tv_nsec += 1000000L;
+    if (until.tv_nsec >= 1000000000L) {
+       until.tv_nsec -= 1000000000L;
+       until.tv_sec++;
+    }
+    pthread_cond_timedwait(&host_event_cond, &host_event_mutex, &until);
+ }
+ host_event[host_core] = 0;
+ pthread_mutex_unlock(&host_event_mutex);
+}
+
+/*
+32 spin locks like on the RP2040, claimed from the first one.
+*/
+static spin_lock_t host_spin_locks[32];
+static int host_spin_claimed = 0;
+
+spin_lock_t *spin_lock_instance(unsigned int lock_num)
+{
+ return &host_spin_locks[lock_num % 32];
+}
+
+int spin_lock_claim_unused(bool required)
+{
+ int lock_num = __atomic_fetch_add(&host_spin_claimed, 1, __ATOMIC_SEQ_CST);
+ if (lock_num >= 32) {
+    if (required) {
+       fprintf(stderr, "No free spin lock\n");
+       exit(EXIT_FAILURE);
+    }
+    return -1;
+ }
+ return lock_num;
+}
+
+uint32_t spin_lock_blocking(spin_lock_t *lock)
+{
+ while (__atomic_exchange_n(lock, 1, __ATOMIC_ACQUIRE) != 0);
+ return 0;
+}
+
+void spin_unlock(spin_lock_t *lock, uint32_t saved_irq)
+{
+ (void)saved_irq;
+ __atomic_store_n(lock, 0, __ATOMIC_RELEASE);
+}
+
+///////////////////////
+/// W5100S          ///
+///////////////////////
+void wizchip_spi_initialize(void) {}
+void wizchip_cris_initialize(void) {}
+void wizchip_reset(void) {}
+void wizchip_initialize(void) {}
+void wizchip_check(void) {}
+
+/*
+Networking data are only kept for print, host uses its own interfaces.
+*/
+void network_initialize(wiz_NetInfo net_info)
+{
+ (void)net_info;
+}
+
+void print_network_information(wiz_NetInfo net_info)
+{
+ printf("====================================================================================================\n");
+ printf(" %s network configuration : %s\n", "W5100S(host)",
+        net_info.dhcp == NETINFO_DHCP ? "DHCP" : "static");
+ printf(" MAC         : %02X:%02X:%02X:%02X:%02X:%02X\n", net_info.mac[0],
+        net_info.mac[1], net_info.mac[2], net_info.mac[3], net_info.mac[4], net_info.mac[5]);
+ printf(" IP          : %d.%d.%d.%d\n", net_info.ip[0], net_info.ip[1], net_info.ip[2], net_info.ip[3]);
+ printf(" Subnet Mask : %d.%d.%d.%d\n", net_info.sn[0], net_info.sn[1], net_info.sn[2], net_info.sn[3]);
+ printf(" Gateway     : %d.%d.%d.%d\n", net_info.gw[0], net_info.gw[1], net_info.gw[2], net_info.gw[3]);
+ printf(" DNS         : %d.%d.%d.%d\n", net_info.dns[0], net_info.dns[1], net_info.dns[2], net_info.dns[3]);
+ printf("====================================================================================================\n\n");
+}
+
+///////////////////////
+/// DHCP            ///
+///////////////////////
+/*
+Callback for the assigned address and loopback lease of the emulated server.
+The lease is assigned by the first DHCP_run() after DHCP_init() and stays
+valid until DHCP_stop().
+*/
+static void (*dhcp_ip_assign)(void) = NULL;
+static int dhcp_leased = 0;
+static const uint8_t dhcp_ip[4] = {127, 0, 0, 1};
+static const uint8_t dhcp_sn[4] = {255, 0, 0, 0};
+
+void DHCP_init(uint8_t s, uint8_t *buf)
+{
+ (void)s;
+ (void)buf;
+ dhcp_leased = 0;
+}
+
+void reg_dhcp_cbfunc(void (*ip_assign)(void), void (*ip_update)(void), void (*ip_conflict)(void))
+{
+ (void)ip_update;
+ (void)ip_conflict;
+ dhcp_ip_assign = ip_assign;
+}
+
+uint8_t DHCP_run(void)
+{
+ if (dhcp_leased) return DHCP_IP_LEASED;
+ if (dhcp_ip_assign != NULL) dhcp_ip_assign();
+ dhcp_leased = 1;
+ return DHCP_IP_LEASED;
+}
+
+void DHCP_stop(void) { dhcp_leased = 0; }
+void DHCP_time_handler(void) {}
+void getIPfromDHCP(uint8_t *ip) { memcpy(ip, dhcp_ip, 4); }
+void getGWfromDHCP(uint8_t *ip) { memcpy(ip, dhcp_ip, 4); }
+void getSNfromDHCP(uint8_t *ip) { memcpy(ip, dhcp_sn, 4); }
+void getDNSfromDHCP(uint8_t *ip) { memcpy(ip, dhcp_ip, 4); }
+uint32_t getDHCPLeasetime(void) { return 86400; }
+
+///////////////////////
+/// Entropy         ///
+///////////////////////
+/*
+Entropy for XDRBG seeding comes from the kernel instead of ROSC/RAM hash.
+*/
+uint64_t get_rand_64(void)
+{
+ uint64_t value = 0;
+ uint8_t *ptr = (uint8_t *)&value;
+ size_t done = 0;
+ while (done < sizeof(value)) {
+    ssize_t retval = getrandom(ptr + done, sizeof(value) - done, 0);
+    if (retval < 0) {
+       if (errno == EINTR) continue;
+       abort(); // No entropy means XDRBG must not be seeded
+    }
+    done += (size_t)retval;
+ }
+ return value;
+}
@@ -0,0 +1,107 @@
+// Client-server API(PICO)        //
+// Host HAL: flash memory         //
+// Version 0.9.1pi                //
+// Bachelor's Work Project        //
+// Technical University of Kosice //
+// 17.10.2026                     //
+// Nikita Kuropatkin              //
+// Host emulation of              //
+// W5100S-EVB-Pico                //
+
+/*
+Flash memory emulated by a RAM image mirrored to a file for the
+Linux host build. Erased flash reads as 0xFF, like on the chip.
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "include/hardware/flash.h"
+#include "include/pico/flash.h"
+
+/*Image of the whole flash(XIP_BASE points here)*/
+uint8_t host_xip_image[PICO_FLASH_SIZE_BYTES];
+
+/*
+Returns the path of the flash image file.
+*/
+static const char *host_flash_path(void)
+{
+ const char *path = getenv("CLIENT_PICO_FLASH");
+ return (path != NULL && path[0] != '\0') ? path : HOST_FLASH_FILE;
+}
+
+/*
+Loads the flash image before main() runs, missing file means
+a freshly erased chip.
+*/
+__attribute__((constructor))
+static void host_flash_load(void)
+{
+ memset(host_xip_image, 0xFF, sizeof(host_xip_image));
+
+ FILE *file = fopen(host_flash_path(), "rb");
+ if (file == NULL) return;
+ size_t len = fread(host_xip_image, 1, sizeof(host_xip_image), file);
+ (void)len; // Shorter file leaves the rest erased
+ fclose(file);
+}
+
+/*
+Writes `count` bytes of the image from `flash_offs` back to the file.
+*/
+static void host_flash_store(const uint32_t flash_offs, const size_t count)
+{
+ const char *path = host_flash_path();
+ FILE *file = fopen(path, "r+b");
+ if (file == NULL) {
+    // First write creates a full-size erased image
+    file = fopen(path, "w+b");
+    if (file == NULL) return;
+    fwrite(host_xip_image, 1, sizeof(host_xip_image), file);
+ }
+ else if (fseek(file, (long)flash_offs, SEEK_SET) == 0) {
+    fwrite(&host_xip_image[flash_offs], 1, count, file);
+ }
+ fclose(file);
+}
+
+/*
+Erases `count` bytes(whole sectors) from `flash_offs`.
+*/
+void flash_range_erase(uint32_t flash_offs, size_t count)
+{
+ if (flash_offs + count > PICO_FLASH_SIZE_BYTES) return;
+ memset(&host_xip_image[flash_offs], 0xFF, count);
+ host_flash_store(flash_offs, count);
+}
+
+/*
+Programs `count` bytes(whole pages) from `flash_offs`.
+Like NOR flash, programming can only clear bits.
+*/
+void flash_range_program(uint32_t flash_offs, const uint8_t *data, size_t count)
+{
+ if (flash_offs + count > PICO_FLASH_SIZE_BYTES) return;
+ for (size_t i = 0; i < count; i++) {
+    host_xip_image[flash_offs + i] &= data[i];
+ }
+ host_flash_store(flash_offs, count);
+}
+
+/*
+There is no other core and no XIP cache on host, `func` is just called.
+*/
+int flash_safe_execute(void (*func)(void *), void *param, uint32_t enter_exit_timeout_ms)
+{
+ (void)enter_exit_timeout_ms;
+ func(param);
+ return PICO_OK;
+}
+
+/*
+Second core(thread) does not execute from flash on host.
+*/
+bool flash_safe_execute_core_init(void)
+{
+ return true;
+}
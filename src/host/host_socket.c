@@ -0,0 +1,160 @@
+// Client-server API(PICO)        //
+// Host HAL: WIZnet socket API    //
+// Version 0.9.1pi                //
+// Bachelor's Work Project        //
+// Technical University of Kosice //
+// 17.10.2026                     //
+// Nikita Kuropatkin              //
+// Host emulation of              //
+// W5100S-EVB-Pico                //
+
+/*
+WIZnet socket API emulated with BSD sockets for the Linux host build.
+Every hardware socket number is mapped to one file descriptor.
+*/
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+
+#define HOST_SOCKET_IMPL // Keep libc names, WIZnet ones are wiz_host_*
+#include "include/socket.h"
+
+/*File descriptors of emulated hardware sockets(-1 means closed)*/
+static int host_fd[_WIZCHIP_SOCK_NUM_] = {-1, -1, -1, -1};
+
+/*
+Opens socket `sn` in TCP mode. The local `port` is not bound, because on
+loopback the server itself already listens on the same port number.
+*/
+int8_t wiz_host_socket(uint8_t sn, uint8_t protocol, uint16_t port, uint8_t flag)
+{
+ (void)port;
+ if (sn >= _WIZCHIP_SOCK_NUM_) return SOCKERR_SOCKNUM;
+ if (protocol != Sn_MR_TCP) return SOCKERR_SOCKMODE;
+
+ wiz_host_close(sn); // Same as on the chip, socket is closed first
+
+ int fd = socket(AF_INET, SOCK_STREAM, 0);
+ if (fd < 0) return SOCKERR_SOCKNUM;
+
+ if (flag & SF_TCP_NODELAY) {
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+ }
+ host_fd[sn] = fd;
+ return sn;
+}
+
+/*
+Connects socket `sn` to `addr`:`port`. Refused or unreachable server is
+reported as SOCKERR_TIMEOUT, like ARP/TCP timeout on the chip.
+*/
+int8_t wiz_host_connect(uint8_t sn, uint8_t *addr, uint16_t port)
+{
+ if (sn >= _WIZCHIP_SOCK_NUM_ || host_fd[sn] < 0) return SOCKERR_SOCKNUM;
+
+ struct sockaddr_in server;
+ memset(&server, 0, sizeof(server));
+ server.sin_family = AF_INET;
+ server.sin_port = htons(port);
+ memcpy(&server.sin_addr.s_addr, addr, 4); // Already in network order
+
+ if (connect(host_fd[sn], (struct sockaddr *)&server, sizeof(server)) != 0) {
+    return SOCKERR_TIMEOUT;
+ }
+ return SOCK_OK;
+}
+
+/*
+Receives at most `len` bytes, like on the chip it returns whatever
+is in the receive buffer(so the result can be shorter than `len`).
+*/
+int32_t wiz_host_recv(uint8_t sn, uint8_t *buf, uint16_t len)
+{
+ if (sn >= _WIZCHIP_SOCK_NUM_ || host_fd[sn] < 0) return SOCKERR_SOCKNUM;
+ if (len == 0) return SOCKERR_DATALEN;
+ if (len > HOST_SOCK_BUF_SIZE) len = HOST_SOCK_BUF_SIZE;
+
+ ssize_t retval;
+ do {
+    retval = recv(host_fd[sn], buf, len, 0);
+ } while (retval < 0 && errno == EINTR);
+
+ if (retval <= 0) return SOCKERR_SOCKSTATUS; // Peer closed or error
+ return (int32_t)retval;
+}
+
+/*
+Sends `len` bytes, `len` is limited by size of socket TX memory.
+*/
+int32_t wiz_host_send(uint8_t sn, uint8_t *buf, uint16_t len)
+{
+ if (sn >= _WIZCHIP_SOCK_NUM_ || host_fd[sn] < 0) return SOCKERR_SOCKNUM;
+ if (len == 0) return SOCKERR_DATALEN;
+ if (len > HOST_SOCK_BUF_SIZE) len = HOST_SOCK_BUF_SIZE;
+
+ uint16_t sent = 0;
+ while (sent < len) {
+    ssize_t retval = send(host_fd[sn], buf + sent, len - sent, MSG_NOSIGNAL);
+    if (retval < 0 && errno == EINTR) continue;
+    if (retval <= 0) return SOCKERR_SOCKSTATUS;
+    sent += (uint16_t)retval;
+ }
+ return sent;
+}
+
+/*
+Received size register: bytes that recv() can return without waiting.
+*/
+uint16_t getSn_RX_RSR(uint8_t sn)
+{
+ int avail = 0;
+ if (sn >= _WIZCHIP_SOCK_NUM_ || host_fd[sn] < 0) return 0;
+ if (ioctl(host_fd[sn], FIONREAD, &avail) != 0 || avail < 0) return 0;
+ return (avail > HOST_SOCK_BUF_SIZE) ? HOST_SOCK_BUF_SIZE : (uint16_t)avail;
+}
+
+/*
+Status register: ESTABLISHED, CLOSE_WAIT after FIN of the peer,
+CLOSED for a closed socket or a connection error.
+*/
+uint8_t getSn_SR(uint8_t sn)
+{
+ uint8_t peek;
+ if (sn >= _WIZCHIP_SOCK_NUM_ || host_fd[sn] < 0) return SOCK_CLOSED;
+
+ ssize_t retval = recv(host_fd[sn], &peek, 1, MSG_PEEK | MSG_DONTWAIT);
+ if (retval == 0) return SOCK_CLOSE_WAIT;
+ if (retval < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+    return SOCK_CLOSED;
+ }
+ return SOCK_ESTABLISHED;
+}
+
+/*
+Closes socket `sn`.
+*/
+int8_t wiz_host_close(uint8_t sn)
+{
+ if (sn >= _WIZCHIP_SOCK_NUM_) return SOCKERR_SOCKNUM;
+ if (host_fd[sn] >= 0) {
+    close(host_fd[sn]);
+    host_fd[sn] = -1;
+ }
+ return SOCK_OK;
+}
+
+/*
+Sends FIN on socket `sn`.
+*/
+int8_t wiz_host_disconnect(uint8_t sn)
+{
+ if (sn >= _WIZCHIP_SOCK_NUM_ || host_fd[sn] < 0) return SOCKERR_SOCKNUM;
+ shutdown(host_fd[sn], SHUT_WR);
+ return SOCK_OK;
+}
@@ -0,0 +1,41 @@
+// Client-server API(PICO)        //
+// Host HAL: DHCP client          //
+// Version 0.9.1pi                //
+// Bachelor's Work Project        //
+// Technical University of Kosice //
+// 17.10.2026                     //
+// Nikita Kuropatkin              //
+// Host emulation of              //
+// W5100S-EVB-Pico                //
+
+/*
+Replacement of ioLibrary`s dhcp.h for the Linux host build.
+The emulated DHCP server always leases loopback settings(127.0.0.1/8)
+on the first DHCP_run() call after DHCP_init(). Bodies are in src/host/host_board.c.
+*/
+#ifndef _DHCP_H_
+#define _DHCP_H_
+#include <stdint.h>
+
+/*Return values of DHCP_run()(same values as in ioLibrary)*/
+enum {
+  DHCP_FAILED = 0,
+  DHCP_RUNNING,
+  DHCP_IP_ASSIGN,
+  DHCP_IP_CHANGED,
+  DHCP_IP_LEASED,
+  DHCP_STOPPED
+};
+
+void DHCP_init(uint8_t s, uint8_t *buf);
+void reg_dhcp_cbfunc(void (*ip_assign)(void), void (*ip_update)(void), void (*ip_conflict)(void));
+uint8_t DHCP_run(void);
+void DHCP_stop(void);
+void DHCP_time_handler(void);
+void getIPfromDHCP(uint8_t *ip);
+void getGWfromDHCP(uint8_t *ip);
+void getSNfromDHCP(uint8_t *ip);
+void getDNSfromDHCP(uint8_t *ip);
+uint32_t getDHCPLeasetime(void);
+
+#endif
@@ -0,0 +1,39 @@
+// Client-server API(PICO)        //
+// Host HAL: Pico SDK flash       //
+// Version 0.9.1pi                //
+// Bachelor's Work Project        //
+// Technical University of Kosice //
+// 17.10.2026                     //
+// Nikita Kuropatkin              //
+// Host emulation of              //
+// W5100S-EVB-Pico                //
+
+/*
+Replacement of Pico SDK hardware/flash.h for the Linux host build.
+Flash is an array in RAM mirrored to a file, so key, salt and networking
+data persist between runs like on the board.
+The file is chosen by CLIENT_PICO_FLASH environment variable
+(HOST_FLASH_FILE by default). Bodies are in src/host/host_flash.c.
+*/
+#ifndef _HARDWARE_FLASH_H
+#define _HARDWARE_FLASH_H
+#include "pico.h"
+
+#define FLASH_PAGE_SIZE (1u << 8)
+#define FLASH_SECTOR_SIZE (1u << 12)
+#define PICO_FLASH_SIZE_BYTES (2 * 1024 * 1024)
+
+/*Default name of the file with flash image*/
+#define HOST_FLASH_FILE "client_pico_flash.bin"
+
+/*
+Image of the flash memory. XIP_BASE points to it, so reads like
+`(uint8_t *)(XIP_BASE + FLASH_PAGE)` work unchanged.
+*/
+extern uint8_t host_xip_image[PICO_FLASH_SIZE_BYTES];
+#define XIP_BASE (host_xip_image)
+
+void flash_range_erase(uint32_t flash_offs, size_t count);
+void flash_range_program(uint32_t flash_offs, const uint8_t *data, size_t count);
+
+#endif
@@ -0,0 +1,41 @@
+// Client-server API(PICO)        //
+// Host HAL: Pico SDK sync        //
+// Version 0.9.1pi                //
+// Bachelor's Work Project        //
+// Technical University of Kosice //
+// 17.10.2026                     //
+// Nikita Kuropatkin              //
+// Host emulation of              //
+// W5100S-EVB-Pico                //
+
+/*
+Replacement of Pico SDK hardware/sync.h for the Linux host build.
+Bodies are in src/host/host_board.c.
+*/
+#ifndef _HARDWARE_SYNC_H
+#define _HARDWARE_SYNC_H
+#include "pico.h"
+
+/*
+Full memory barrier(DMB instruction on the RP2040).
+*/
+void __dmb(void);
+
+/*
+Event between cores(SEV/WFE), each core(thread) has its event register.
+__wfe() returns at the latest after 1 ms.
+*/
+void __sev(void);
+void __wfe(void);
+
+/*
+Spin locks of the SIO block, emulated by atomic exchange. 
+Interrupts do not exist on host, saved state is always 0.
+*/
+typedef volatile uint32_t spin_lock_t;
+spin_lock_t *spin_lock_instance(unsigned int lock_num);
+int spin_lock_claim_unused(bool required);
+uint32_t spin_lock_blocking(spin_lock_t *lock);
+void spin_unlock(spin_lock_t *lock, uint32_t saved_irq);
+
+#endif
@@ -0,0 +1,26 @@
+// Client-server API(PICO)        //
+// Host HAL: Pico SDK watchdog    //
+// Version 0.9.1pi                //
+// Bachelor's Work Project        //
+// Technical University of Kosice //
+// 17.10.2026                     //
+// Nikita Kuropatkin              //
+// Host emulation of              //
+// W5100S-EVB-Pico                //
+
+/*
+Replacement of Pico SDK hardware/watchdog.h for the Linux host build.
+Body is in src/host/host_board.c.
+*/
+#ifndef _HARDWARE_WATCHDOG_H
+#define _HARDWARE_WATCHDOG_H
+#include "pico.h"
+
+/*
+"Reboots" the host emulator by ending the process.
+Immediate reboot(`delay_ms` == 0, end of main()) exits with success,
+delayed reboot(used by exit_with_error()) exits with failure status.
+*/
+void watchdog_reboot(uint32_t pc, uint32_t sp, uint32_t delay_ms);
+
+#endif
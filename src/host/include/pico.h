@@ -0,0 +1,36 @@
+// Client-server API(PICO)        //
+// Host HAL: Pico SDK base        //
+// Version 0.9.1pi                //
+// Bachelor's Work Project        //
+// Technical University of Kosice //
+// 17.10.2026                     //
+// Nikita Kuropatkin              //
+// Host emulation of              //
+// W5100S-EVB-Pico                //
+
+/*
+Replacement of Pico SDK pico.h for the Linux host build.
+*/
+#ifndef _PICO_H
+#define _PICO_H
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/*Same value as in pico/error.h*/
+#define PICO_OK 0
+#define PICO_ERROR_TIMEOUT -1
+#define PICO_ERROR_GENERIC -2
+
+/*Host build does not run on the RP2040*/
+#ifndef PICO_ON_DEVICE
+  #define PICO_ON_DEVICE 0
+#endif
+
+/*
+Number of the core which runs the caller, 1 in the thread of core1
+(multicore_launch_core1_with_stack()). Body is in src/host/host_board.c.
+*/
+unsigned int get_core_num(void);
+
+#endif
@@ -0,0 +1,30 @@
+// Client-server API(PICO)        //
+// Host HAL: Pico SDK safe flash  //
+// Version 0.9.1pi                //
+// Bachelor's Work Project        //
+// Technical University of Kosice //
+// 17.10.2026                     //
+// Nikita Kuropatkin              //
+// Host emulation of              //
+// W5100S-EVB-Pico                //
+
+/*
+Replacement of Pico SDK pico/flash.h for the Linux host build.
+Body is in src/host/host_flash.c.
+*/
+#ifndef _PICO_FLASH_H
+#define _PICO_FLASH_H
+#include "pico.h"
+
+/*
+Runs `func` with `param`(there is no second core or XIP to lock on host).
+Always returns PICO_OK.
+*/
+int flash_safe_execute(void (*func)(void *), void *param, uint32_t enter_exit_timeout_ms);
+
+/*
+Nothing to prepare on host, always returns true.
+*/
+bool flash_safe_execute_core_init(void);
+
+#endif
@@ -0,0 +1,25 @@
+// Client-server API(PICO)        //
+// Host HAL: Pico SDK multicore   //
+// Version 0.9.1pi                //
+// Bachelor's Work Project        //
+// Technical University of Kosice //
+// 17.10.2026                     //
+// Nikita Kuropatkin              //
+// Host emulation of              //
+// W5100S-EVB-Pico                //
+
+/*
+Replacement of Pico SDK pico/multicore.h for the Linux host build.
+Core1 is emulated with a detached thread. Body is in src/host/host_board.c.
+*/
+#ifndef _PICO_MULTICORE_H
+#define _PICO_MULTICORE_H
+#include "pico.h"
+
+/*
+Runs `entry` in a new thread, the stack is allocated by the system
+(`stack_bottom` and `stack_size_bytes` are ignored).
+*/
+void multicore_launch_core1_with_stack(void (*entry)(void), uint32_t *stack_bottom, size_t stack_size_bytes);
+
+#endif
@@ -0,0 +1,18 @@
+// Client-server API(PICO)        //
+// Host HAL: Pico SDK stdio UART  //
+// Version 0.9.1pi                //
+// Bachelor's Work Project        //
+// Technical University of Kosice //
+// 17.10.2026                     //
+// Nikita Kuropatkin              //
+// Host emulation of              //
+// W5100S-EVB-Pico                //
+
+/*
+Replacement of Pico SDK pico/stdio_uart.h for the Linux host build.
+*/
+#ifndef _PICO_STDIO_UART_H
+#define _PICO_STDIO_UART_H
+#include "pico/stdlib.h"
+
+#endif
@@ -0,0 +1,52 @@
+// Client-server API(PICO)        //
+// Host HAL: Pico SDK stdlib      //
+// Version 0.9.1pi                //
+// Bachelor's Work Project        //
+// Technical University of Kosice //
+// 17.10.2026                     //
+// Nikita Kuropatkin              //
+// Host emulation of              //
+// W5100S-EVB-Pico                //
+
+/*
+Replacement of Pico SDK pico/stdlib.h for the Linux host build.
+UART of the board is mapped to stdin/stdout of the process.
+Bodies are in src/host/host_board.c.
+*/
+#ifndef _PICO_STDLIB_H
+#define _PICO_STDLIB_H
+#include "pico.h"
+
+typedef struct uart_inst uart_inst_t;
+#define uart0 ((uart_inst_t *)0)
+#define GPIO_FUNC_UART 2
+
+void sleep_ms(uint32_t ms);
+void sleep_us(uint64_t us);
+
+/*
+Microseconds since boot(process start on host), like the RP2040 timer.
+*/
+uint64_t time_us_64(void);
+uint32_t time_us_32(void);
+bool stdio_uart_init(void);
+bool stdio_usb_init(void);
+void gpio_set_function(unsigned int gpio, unsigned int fn);
+void uart_set_fifo_enabled(uart_inst_t *uart, bool enabled);
+void uart_set_hw_flow(uart_inst_t *uart, bool cts, bool rts);
+void uart_puts(uart_inst_t *uart, const char *s);
+
+/*
+Returns true while the current line on stdin was not consumed yet,
+so the welcome loop in chip_init.c eats exactly one line of input.
+*/
+bool uart_is_readable(uart_inst_t *uart);
+char uart_getc(uart_inst_t *uart);
+
+/*
+Returns the next character from stdin, or PICO_ERROR_TIMEOUT if none 
+arrived in `timeout_us`. On host the end of stdin is PICO_ERROR_GENERIC.
+*/
+int getchar_timeout_us(uint32_t timeout_us);
+
+#endif
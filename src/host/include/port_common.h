@@ -0,0 +1,28 @@
+// Client-server API(PICO)        //
+// Host HAL: WIZnet port common   //
+// Version 0.9.1pi                //
+// Bachelor's Work Project        //
+// Technical University of Kosice //
+// 17.10.2026                     //
+// Nikita Kuropatkin              //
+// Host emulation of              //
+// W5100S-EVB-Pico                //
+
+/*
+Replacement of WIZnet port_common.h for the Linux host build.
+Declares clock functions of the Pico SDK, that are no-ops on the host.
+*/
+#ifndef _PORT_COMMON_H_
+#define _PORT_COMMON_H_
+#include <stdint.h>
+#include <stdbool.h>
+#include "pico/stdlib.h"
+
+/*Clock identifiers and sources used by timing.c*/
+enum clock_index { clk_gpout0 = 0, clk_ref = 4, clk_sys, clk_peri };
+#define CLOCKS_CLK_PERI_CTRL_AUXSRC_VALUE_CLKSRC_PLL_SYS 0x1
+
+bool set_sys_clock_khz(uint32_t freq_khz, bool required);
+bool clock_configure(enum clock_index clk_index, uint32_t src, uint32_t auxsrc, uint32_t src_freq, uint32_t freq);
+
+#endif
@@ -0,0 +1,108 @@
+// Client-server API(PICO)        //
+// Host HAL: WIZnet socket API    //
+// Version 0.9.1pi                //
+// Bachelor's Work Project        //
+// Technical University of Kosice //
+// 17.10.2026                     //
+// Nikita Kuropatkin              //
+// Host emulation of              //
+// W5100S-EVB-Pico                //
+
+/*
+Replacement of ioLibrary`s socket.h for the Linux host build.
+WIZnet socket API is mapped onto BSD sockets, so the client code can
+call socket()/connect()/recv()/send()/close() exactly as on the chip.
+Because the WIZnet names collide with libc, they are renamed by macros
+to wiz_host_* functions (bodies are in src/host/host_socket.c).
+Return values and flags are the same as in ioLibrary.
+*/
+#ifndef _SOCKET_H_
+#define _SOCKET_H_
+#include <stdint.h>
+#include "wizchip_conf.h"
+
+/*Number of hardware sockets of W5100S*/
+#define _WIZCHIP_SOCK_NUM_ 4
+
+/*
+Size of TX/RX memory of one socket on W5100S(default 2 KB).
+send() and recv() never move more than this in one call, like on the chip.
+*/
+#define HOST_SOCK_BUF_SIZE 2048
+
+/*Return values of socket functions*/
+#define SOCK_OK 1
+#define SOCK_BUSY 0
+#define SOCK_ERROR 0
+#define SOCKERR_SOCKNUM (SOCK_ERROR - 1)
+#define SOCKERR_SOCKCLOSED (SOCK_ERROR - 4)
+#define SOCKERR_SOCKMODE (SOCK_ERROR - 5)
+#define SOCKERR_SOCKSTATUS (SOCK_ERROR - 7)
+#define SOCKERR_TIMEOUT (SOCK_ERROR - 13)
+#define SOCKERR_DATALEN (SOCK_ERROR - 14)
+
+/*Timeout of connecting(ms) used by client.c, defined by WIZnet port*/
+#define RECV_TIMEOUT (1000 * 10)
+
+/*Socket mode and flags*/
+#define Sn_MR_TCP 0x01
+#define Sn_MR_ND 0x20
+#define SF_TCP_NODELAY (Sn_MR_ND)
+
+/*Socket status values(Sn_SR register)*/
+#define SOCK_CLOSED 0x00
+#define SOCK_ESTABLISHED 0x17
+#define SOCK_CLOSE_WAIT 0x1C
+
+#ifndef HOST_SOCKET_IMPL
+  #define socket wiz_host_socket
+  #define connect wiz_host_connect
+  #define recv wiz_host_recv
+  #define send wiz_host_send
+  #define close wiz_host_close
+  #define disconnect wiz_host_disconnect
+#endif
+
+/*
+Opens socket `sn` in `protocol` mode(only Sn_MR_TCP is emulated).
+Returns `sn` on success.
+*/
+int8_t wiz_host_socket(uint8_t sn, uint8_t protocol, uint16_t port, uint8_t flag);
+
+/*
+Connects socket `sn` to the server `addr`:`port`(blocking).
+Returns SOCK_OK on success or SOCKERR_TIMEOUT when server is unreachable.
+*/
+int8_t wiz_host_connect(uint8_t sn, uint8_t *addr, uint16_t port);
+
+/*
+Receives at most `len` bytes(blocking until at least one byte is available).
+Returns amount of received bytes or SOCKERR_SOCKSTATUS if connection is lost.
+*/
+int32_t wiz_host_recv(uint8_t sn, uint8_t *buf, uint16_t len);
+
+/*
+Sends `len` bytes(blocking), `len` is limited by HOST_SOCK_BUF_SIZE.
+Returns amount of sent bytes or SOCKERR_SOCKSTATUS if connection is lost.
+*/
+int32_t wiz_host_send(uint8_t sn, uint8_t *buf, uint16_t len);
+
+/*
+Register access of W5100S(on the chip from w5100s.h via wizchip_conf.h).
+getSn_RX_RSR() returns amount of received bytes waiting in RX memory
+(at most HOST_SOCK_BUF_SIZE), getSn_SR() returns status of the socket.
+*/
+uint16_t getSn_RX_RSR(uint8_t sn);
+uint8_t getSn_SR(uint8_t sn);
+
+/*
+Closes socket `sn`. Always returns SOCK_OK.
+*/
+int8_t wiz_host_close(uint8_t sn);
+
+/*
+Shuts down the connection of socket `sn`. Always returns SOCK_OK.
+*/
+int8_t wiz_host_disconnect(uint8_t sn);
+
+#endif
@@ -0,0 +1,29 @@
+// Client-server API(PICO)        //
+// Host HAL: WIZnet 1 ms timer    //
+// Version 0.9.1pi                //
+// Bachelor's Work Project        //
+// Technical University of Kosice //
+// 17.10.2026                     //
+// Nikita Kuropatkin              //
+// Host emulation of              //
+// W5100S-EVB-Pico                //
+
+/*
+Replacement of WIZnet port timer.h for the Linux host build.
+The repeating 1 ms timer is emulated by a thread.
+Bodies are in src/host/host_board.c.
+*/
+#ifndef _TIMER_H_
+#define _TIMER_H_
+#include <stdint.h>
+
+/*
+Calls `callback` every millisecond, every call adds one more timer
+(exactly like add_repeating_timer_us() on the chip).
+*/
+void wizchip_1ms_timer_initialize(void (*callback)(void));
+
+/*Blocks for `ms` milliseconds*/
+void wizchip_delay_ms(uint32_t ms);
+
+#endif
@@ -0,0 +1,30 @@
+// Client-server API(PICO)        //
+// Host HAL: W5x00 SPI port       //
+// Version 0.9.1pi                //
+// Bachelor's Work Project        //
+// Technical University of Kosice //
+// 17.10.2026                     //
+// Nikita Kuropatkin              //
+// Host emulation of              //
+// W5100S-EVB-Pico                //
+
+/*
+Replacement of WIZnet port w5x00_spi.h for the Linux host build.
+There is no chip on the host, so initialization functions only
+print what would be configured. Bodies are in src/host/host_board.c.
+*/
+#ifndef _W5X00_SPI_H_
+#define _W5X00_SPI_H_
+#include <stdint.h>
+#include "wizchip_conf.h"
+
+void wizchip_spi_initialize(void);
+void wizchip_cris_initialize(void);
+void wizchip_reset(void);
+void wizchip_initialize(void);
+void wizchip_check(void);
+void network_initialize(wiz_NetInfo net_info);
+void print_network_information(wiz_NetInfo net_info);
+void wiz_delay_ms(uint32_t ms);
+
+#endif
@@ -0,0 +1,37 @@
+// Client-server API(PICO)        //
+// Host HAL: WIZnet chip config   //
+// Version 0.9.1pi                //
+// Bachelor's Work Project        //
+// Technical University of Kosice //
+// 17.10.2026                     //
+// Nikita Kuropatkin              //
+// Host emulation of              //
+// W5100S-EVB-Pico                //
+
+/*
+Replacement of ioLibrary`s wizchip_conf.h for the Linux host build.
+Only the network information structure used by the client is declared,
+the layout is the same as in ioLibrary.
+*/
+#ifndef _WIZCHIP_CONF_H_
+#define _WIZCHIP_CONF_H_
+#include <stdint.h>
+#include <stddef.h>
+
+/*Selects static or DHCP networking data(same values as in ioLibrary)*/
+typedef enum {
+  NETINFO_STATIC = 1, // Static IP configuration by manually
+  NETINFO_DHCP        // Dynamic IP configuration from a DHCP server
+} dhcp_mode;
+
+/*Networking data of the chip*/
+typedef struct wiz_NetInfo_t {
+  uint8_t mac[6];  // Source MAC address
+  uint8_t ip[4];   // Source IP address
+  uint8_t sn[4];   // Subnet mask
+  uint8_t gw[4];   // Gateway IP address
+  uint8_t dns[4];  // DNS server IP address
+  dhcp_mode dhcp;  // 1 - Static, 2 - DHCP
+} wiz_NetInfo;
+
+#endif
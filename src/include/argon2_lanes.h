@@ -0,0 +1,47 @@
+// Client-server API(PICO)        //
+// Argon2 on two cores            //
+// Version 0.9.1pi                //
+// Bachelor's Work Project        //
+// Technical University of Kosice //
+// 17.10.2026                     //
+// Nikita Kuropatkin              //
+// Version for MCU                //
+// W5100S-EVB-Pico                //
+
+/*
+This header file declares Argon2 with lanes filled by both cores of RP2040
+(threads on host). The output is identical to crypto_argon2() from
+Monocypher, which fills lanes one after another on one core.
+Every slice is split into segments(one per lane), a core takes the next
+free segment of the slice, and the next slice starts when all segments
+are finished(barrier). The core calling argon2_lanes() always fills
+segments, the other core joins by calling argon2_lanes_help().
+Function bodies are in argon2_lanes.c.
+*/
+#ifndef ARGON2_LANES_H
+#define ARGON2_LANES_H
+#include <stdint.h>
+#include "monocypher.h"
+
+/*
+Argon2 with the same parameters and output as crypto_argon2().
+Segments are shared with the core that calls argon2_lanes_help(),
+without it all lanes are filled by this core. Only one call can
+run at a time.
+Parameters:
+- `hash`: Output hash(`hash_size` bytes).
+- `work_area`: Memory of `config.nb_blocks` KB, 8-byte aligned.
+- `config`, `inputs`, `extras`: Same as for crypto_argon2().
+*/
+void argon2_lanes(uint8_t *hash, uint32_t hash_size, void *work_area,
+                  crypto_argon2_config config,
+                  crypto_argon2_inputs inputs,
+                  crypto_argon2_extras extras);
+
+/*
+Fills free segments of the running argon2_lanes() on the calling core
+until it finishes. If nothing runs, waits for an event(WFE) and returns.
+*/
+void argon2_lanes_help(void);
+
+#endif
@@ -17,43 +17,7 @@ that helps to generate keys secured by PIN
 #ifndef PIN_H
 #define PIN_H
 #include <stdint.h>
-
-/*
-This function takes an input key and a hashed PIN, and performs an 
-XOR operation on each corresponding element of both arrays. 
-Each byte of the `working_key` is XORed with the corresponding byte of the 
-`hashed_pin` to generate the `result_key`.
-The function can be used to:
-- Transform a plain key into a key secured by a PIN.
-- Convert a key secured by a PIN back to its original plain form.
-Parameters:
-- `result_key`: A pointer to the buffer where the result of the 
-   XOR operation will be stored.
-- `working_key`: A pointer to the working key that will be XORed with 
-  the hashed PIN.
-- `hashed_pin`: A pointer to the hashed PIN that will be used for the 
-  XOR operation.
-*/
-static void xor_with_key(uint8_t *result_key, const uint8_t *working_key, const uint8_t *hashed_pin);
-/////////////////////////////////////////////////
-/////////////////////////////////////////////////
-
-/*
-This function takes an input PIN and hashes it using the Argon2i algorithm. 
-The Argon2i parameters used in this function are predefined in the code and 
-can be modified, but changes should be made with caution to ensure security 
-and proper functioning.
-The function uses Argon2i to hash the `pin` with the provided `salt` and 
-stores the result in the `hashed_pin`.
-Parameters:
-- `pin`: A pointer to the input PIN that will be hashed.
-- `hashed_pin`: A pointer to the buffer where the resulting hashed PIN will 
-  be stored.
-- `salt`: A pointer to the salt that will be used in the hashing process.
-*/
-static void hashing_pin(uint8_t *pin, uint8_t *hashed_pin, uint8_t *salt);
-/////////////////////////////////////////////////
-/////////////////////////////////////////////////
+#include "../monocypher.h"
 
 /*
 This function prompts the user to enter their PIN. 
@@ -70,4 +34,58 @@ void pin_checker(uint8_t *plain_key);
 ///////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////
 
+/*
+Prompts the user to enter the PIN and starts hashing of it on core1, 
+so Argon2i runs while core0 connects to the server and exchanges keys.
+The result is taken by pin_unlock_wait().
+*/
+void pin_unlock_start(void);
+
+/*
+Waits until core1 unlocked the key started by pin_unlock_start(), 
+then moves the key to `plain_key` and wipes the shared copy.
+Parameters:
+- `plain_key`: A pointer to the buffer for the unlocked key.
+*/
+void pin_unlock_wait(uint8_t *plain_key);
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+
+/*
+Makes the key of the session usable for the next session and starts 
+its idle timeout. Call only after the server accepted the key.
+*/
+void pin_cache_confirm(void);
+
+/*
+Wipes the cached key(and the PIN and key kept for calibration), 
+the next session asks for the PIN.
+*/
+void pin_cache_wipe(void);
+
+/*
+Counts idle seconds of the ready cache and wipes it after
+KEY_CACHE_TIMEOUT seconds. Called every second by the 1ms timer.
+*/
+void pin_cache_tick(void);
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+
+/*
+Benchmarks Argon2i on the running board and chooses the largest memory
+and then the most passes that fit into ARGON2_TARGET_MS. The key is 
+secured with them by the next session and stored by pin_calibrate_commit().
+*/
+void pin_calibrate(void);
+
+/*
+Secures the key of the session with the calibrated parameters(one 
+Argon2i run), then stores it, its salt and the parameters to the key 
+page of flash. Call only after the server accepted the unlocked key. 
+Does nothing if no calibration is pending.
+*/
+void pin_calibrate_commit(void);
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+
 #endif
\ No newline at end of file
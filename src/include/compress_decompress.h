@@ -10,14 +10,17 @@
 
 /* 
 This header file declares functions needed for 
-compression/decompression using LZRW3a algorithm of users text for a 
-client-server application. Function bodies
-are in compress_decompress.c. 
+compression/decompression using LZRW3a algorithm(or LZSS, see 
+COMPRESS_BACKEND) of users text for a client-server application. 
+Function bodies are in compress_decompress.c. 
 LZRW3a: http://www.ross.net/compression/lzrw3a.html
 */
 #ifndef COMPRESS_DECOMPRESS_H
 #define COMPRESS_DECOMPRESS_H
 #include <stdint.h>
+#include "parameters.h"
+#include "lzss.h"
+#include "lzrw3a16.h"
 
 /////////////////////////////////////////////
 /// uint32_t to uint8_t Array Converter   ///
@@ -52,13 +55,181 @@ uint32_t from_byte_array( const uint8_t* byte_array, uint32_t number);
 /////////////////////////////////////////////
 /////////////////////////////////////////////
 
+/////////////////////////////
+/// Compressor backends   ///
+/////////////////////////////
+/*
+Compressor used by compress_text()/decompress_text(), selected by
+COMPRESS_BACKEND(parameters.h). Every direction of a context has its
+own work memory of `mem` bytes. The text of a block is preceded by 
+`history` bytes of earlier messages in the same buffer(0 without 
+COMPRESS_STREAM), the output starts with the COMPRESS_PACKED header.
+- `name`: Name for benchmarks.
+- `mem`: Size of the work memory of one direction.
+- `init`: Prepares the work memory for a block without history.
+- `compress`: Compresses `src_len` bytes of `src` to `dst` 
+  (COMPRESS_BOUND(src_len) bytes), the work memory is kept for 
+  the next block.
+- `decompress`: Reverse of `compress`, `dst` is right after the history.
+  At most `dst_max` bytes are written, if the text does not fit or the 
+  input is broken, `dst_len` is set to UINT32_MAX.
+- `rebase`: The history of `used` bytes at `first` has dropped its 
+  first `delta` bytes(compress_slide()), the work memory must follow.
+- `prime`: Adds `size` bytes of a constant dictionary to the work memory
+  after `init`, the dictionary is not copied and must stay in place. 
+  NULL if the backend can not use a dictionary(COMPRESS_DICT).
+*/
+struct compress_backend {
+ const char *name;
+ uint32_t mem;
+ void (*init)(uint8_t *wrk_mem);
+ void (*compress)(uint8_t *wrk_mem, uint8_t *src, uint32_t src_len, uint8_t *dst, uint32_t *dst_len, uint32_t history);
+ void (*decompress)(uint8_t *wrk_mem, uint8_t *src, uint32_t src_len, uint8_t *dst, uint32_t dst_max, uint32_t *dst_len, uint32_t history);
+ void (*rebase)(uint8_t *wrk_mem, uint8_t *first, uint32_t used, uint32_t delta);
+ void (*prime)(uint8_t *wrk_mem, const uint8_t *dict, uint32_t size);
+};
+
+/*
+Available backends:
+- compress_lzrw3a: LZRW3a with 4096 pointer hash table(lzrw3-a.c), 
+  the only one with a dictionary(the table points into it).
+- compress_lzrw3a16: LZRW3a with a table of 16-bit offsets sized for
+  the longest block(lzrw3a16.h), same output as compress_lzrw3a with 
+  4096 entries.
+- compress_lzss: LZSS with LZSS_WINDOW bytes window and 16-bit hash 
+  chains, the decompressor needs no work memory(lzss.c).
+*/
+extern const struct compress_backend compress_lzrw3a;
+extern const struct compress_backend compress_lzrw3a16;
+extern const struct compress_backend compress_lzss;
+
+/*
+Size of the work memory of one direction of the LZRW3a backend, same
+as MEM_REQ in lzrw.h(4096 pointers and alignment fudge), which can 
+not be included here.
+*/
+#define COMPRESS_LZRW3A_MEM (4096 * sizeof(uint8_t *) + 16)
+
+/*
+Size of the work memory of one direction of the selected backend, 
+rounded up to 8 bytes.
+*/
+#if COMPRESS_BACKEND == LZSS
+  #define COMPRESS_TABLE_MEM ((LZSS_MEM + 7) & ~7)
+#elif COMPRESS_BACKEND == LZRW3A16
+  #define COMPRESS_TABLE_MEM ((LZRW3A16_MEM(LZRW3A16_TABLE_BITS) + 7) & ~7)
+#else
+  #define COMPRESS_TABLE_MEM ((COMPRESS_LZRW3A_MEM + 7) & ~7)
+#endif
+/////////////////////////////
+/////////////////////////////
+
+/////////////////////////////
+/// Compression context   ///
+/////////////////////////////
+/*
+Size of the work memory of one context. In stream mode(`stream` YES) 
+every direction has its work memory and history(COMPRESS_HISTORY bytes
+and room for one message, rounded up to 8 bytes): 
+sent table || sent history || received table || received history.
+COMPRESS_STREAM_MEM is the size for the backend with `mem` bytes,
+COMPRESS_CTX_MEM the same with the COMPRESS_STREAM setting.
+*/
+#define COMPRESS_HISTORY_MEM ((COMPRESS_HISTORY + BUFF_MAX + 7) & ~7)
+#define COMPRESS_STREAM_MEM(mem, stream) ((stream) == YES ? \
+  2 * ((((mem) + 7) & ~7) + COMPRESS_HISTORY_MEM) : (((mem) + 7) & ~7))
+#define COMPRESS_CTX_MEM(mem) COMPRESS_STREAM_MEM(mem, COMPRESS_STREAM)
+#define COMPRESS_MEM COMPRESS_CTX_MEM(COMPRESS_TABLE_MEM)
+
+/*
+Compression context of one chat() session. It owns the work memory of
+the backend(COMPRESS_MEM bytes), which is taken once by compress_init()
+and reused by every message in both directions, instead of allocating 
+it for every call of compress_text()/decompress_text(). Where the 
+memory is depends on the ALLOCATION macro(parameters.h): heap(DYNAMIC), 
+BSS(STATIC_BSS, one area for all contexts) or inside of the context on 
+the stack of its owner(STATIC_STACK).
+In stream mode compress_text() and decompress_text() use separate 
+tables and histories, so they must be called in the same order as 
+on the other side for every direction. Without COMPRESS_STREAM both
+directions use one table and there is no history.
+*/
+struct compress_ctx {
+ const struct compress_backend *backend; // Compressor of the session
+ uint8_t *wrk_mem;    // Work memory of the backend and histories
+ uint32_t mem;        // Size of the work memory
+ uint8_t *tx_table;   // Work memory of the backend for sent messages
+ uint8_t *tx_history; // History of sent messages(COMPRESS_STREAM)
+ uint8_t *rx_table;   // Work memory of the backend for received messages
+ uint8_t *rx_history; // History of received messages(COMPRESS_STREAM)
+ int stream;          // YES: messages match the history(COMPRESS_STREAM)
+ uint32_t tx_used;    // Bytes in the history of sent messages
+ uint32_t rx_used;    // Bytes in the history of received messages
+ const uint8_t *dict; // Dictionary in flash(COMPRESS_DICT) or NULL
+ uint32_t dict_size;  // Bytes of the dictionary
+#if ALLOCATION == STATIC_STACK
+ uint8_t area[COMPRESS_MEM] __attribute__((aligned(8))); // Work memory on stack
+#endif
+};
+
+/*
+The function prepares the work memory of `ctx` for the backend 
+selected by COMPRESS_BACKEND and resets it(compress_reset()). 
+The program will exit if the allocation fails.
+*/
+void compress_init(struct compress_ctx *ctx);
+
+/*
+Same as compress_init(), but with `backend` and `stream`(YES: history of
+the session, benchmarks). With static ALLOCATION the work memory must 
+fit COMPRESS_MEM, otherwise the program will exit.
+*/
+void compress_init_backend(struct compress_ctx *ctx, const struct compress_backend *backend, const int stream);
+
+/*
+The function drops the history of both directions, the next messages
+are compressed without it(only with the dictionary). Both sides must 
+reset at the same point(a new AEAD session).
+*/
+void compress_reset(struct compress_ctx *ctx);
+
+/*
+The function wipes and releases the work memory of `ctx`, the context 
+can be initialized again by compress_init().
+*/
+void compress_free(struct compress_ctx *ctx);
+
+/*
+The function releases the context of the running session, if there is 
+one(only one session runs at a time). Called by exit_with_error() 
+while the owner is still on the stack.
+*/
+void compress_abort(void);
+/////////////////////////////
+/////////////////////////////
+
 /////////////////////////
 /// Text Compressors  ///
 /////////////////////////
 /*
-The function compresses `input_txt` using the LZRW3a algorithm,  
-and the compressed text is written to `output_txt`. 
+Header of a compressed message(its first byte, also the copy flag of LZRW3a):
+- COMPRESS_PACKED: output of the backend follows.
+- COMPRESS_STORED: the text follows as it is, it is not decompressed.
+COMPRESS_BOUND is the biggest output of a backend for `n` bytes of text.
+*/
+#define COMPRESS_HEADER 1
+#define COMPRESS_PACKED 0
+#define COMPRESS_STORED 1
+#define COMPRESS_BOUND(n) ((n) + COMPRESS_HEADER + 2 * ((n) / 16 + 1))
+
+/*
+The function compresses `input_txt` using the backend of `ctx`
+(LZRW3a or LZSS), and the compressed text is written to `output_txt`. 
+Texts shorter than COMPRESS_MIN(parameters.h) are stored without 
+running the backend, longer ones are stored if the compressed form is 
+bigger, so the output is at most one byte longer than the text.
 This function takes the following parameters:  
+- `ctx` - compression context(compress_init()) with the work memory.  
 - `input_txt` - the uncompressed text to be compressed.  
 - `max_size` - the maximum size that the compressed text can have.  
 - `output_txt` - a pointer to the buffer where the compressed text 
@@ -74,7 +245,7 @@ than 10%, with the output text being 49 characters long.
 For more information on LZRW3a, see:  
 LZRW3-A: http://www.ross.net/compression/lzrw3a.html
 */
-void compress_text(unsigned char *input_txt, const uint32_t max_size, unsigned  char *output_txt, uint32_t *output_size);
+void compress_text(struct compress_ctx *ctx, unsigned char *input_txt, const uint32_t max_size, unsigned  char *output_txt, uint32_t *output_size);
 /////////////////////////
 /////////////////////////
 
@@ -82,11 +253,14 @@ void compress_text(unsigned char *input_txt, const uint32_t max_size, unsigned
 /// Text Decompressors  ///
 ///////////////////////////
 /*
-The function decompresses `input_txt` using the LZRW3a algorithm,  
+The function decompresses `input_txt` using the backend of `ctx`,  
 and the decompressed text is written to `output_txt`. 
+Stored messages(COMPRESS_STORED header) are only copied.
 This function takes the following parameters:  
+- `ctx` - compression context(compress_init()) with the work memory.  
 - `input_txt` - the compressed text to be decompressed.  
-- `max_size` - the maximum size that the decompressed text can have.  
+- `max_size` - the size of `output_txt`(TEXT_MAX in receive_message()), 
+  a longer text is not written and the program exits.  
 - `input_size` - the size of the compressed text.  
 - `output_txt` - a pointer to the buffer where the decompressed 
   text will be stored.  
@@ -94,7 +268,7 @@ This function takes the following parameters:
 For more information on LZRW3a, see:  
 LZRW3-A: http://www.ross.net/compression/lzrw3a.html
 */
-void decompress_text(unsigned char *input_txt, const uint32_t max_size, unsigned char *output_txt, const uint32_t input_size);
+void decompress_text(struct compress_ctx *ctx, unsigned char *input_txt, const uint32_t max_size, unsigned char *output_txt, const uint32_t input_size);
 ///////////////////////////
 ///////////////////////////
 
@@ -0,0 +1,38 @@
+// Client-server API(PICO)        //
+// Compression dictionary         //
+// Version 0.9.1pi                //
+// Bachelor's Work Project        //
+// Technical University of Kosice //
+// 17.10.2026                     //
+// Nikita Kuropatkin              //
+// Version for MCU                //
+// W5100S-EVB-Pico                //
+
+/*
+This header file declares the dictionary of compress_text() and 
+decompress_text()(COMPRESS_DICT in parameters.h): chat text which the 
+LZRW3-A hash table of every block without history points into, so 
+short messages can match it. It is constant data in flash(XIP on 
+RP2040) and is never copied to RAM. The data is in compress_dict.c, 
+generated by dict_build(bench/dict_build.c) from a corpus of chat 
+lines. Both sides must be built with the same dictionary.
+*/
+#ifndef COMPRESS_DICT_H
+#define COMPRESS_DICT_H
+#include <stdint.h>
+
+/*
+Zero bytes after the dictionary, the longest item of LZRW3-A(18 bytes). 
+Texts have no zero bytes, so no match can run past the end of the 
+dictionary into other data, which differs between the sides.
+*/
+#define COMPRESS_DICT_PAD 18
+
+/*
+Dictionary of `compress_dict_size` bytes and COMPRESS_DICT_PAD zeros,
+the most useful strings are at the end.
+*/
+extern const uint8_t compress_dict[];
+extern const uint32_t compress_dict_size;
+
+#endif
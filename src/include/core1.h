@@ -0,0 +1,62 @@
+// Client-server API(PICO)        //
+// Second core worker             //
+// Version 0.9.1pi                //
+// Bachelor's Work Project        //
+// Technical University of Kosice //
+// 17.10.2026                     //
+// Nikita Kuropatkin              //
+// Version for MCU                //
+// W5100S-EVB-Pico                //
+
+/*
+This header file declares functions of the second core(core1) worker.
+Core1 runs one submitted job at a time(e.g. Argon2i PIN unlock), 
+when there is no job it fills the keypair pool(keypool.c) and sleeps
+when the pool is full.
+Function bodies are in core1.c.
+*/
+#ifndef CORE1_H
+#define CORE1_H
+
+/*
+Launches the worker on core1. Later calls do nothing.
+keypool_start() must be called first.
+*/
+void core1_start(void);
+
+/*
+Hands `job` over to core1, waits first if the previous job still runs.
+Parameters:
+- `job`: Function that core1 runs once.
+*/
+void core1_submit(void (*job)(void));
+
+/*
+Returns YES while a submitted job is not finished, otherwise NO.
+*/
+int core1_busy(void);
+
+/*
+Waits until the submitted job is finished(returns at once if there
+is no job). After return, data written by the job are visible.
+*/
+void core1_wait(void);
+
+/*
+Reports the error of core1 on core0(exit_with_error()), if core1 has
+stopped with one, otherwise returns. Called by core1_wait() and
+keypool_take().
+*/
+void core1_check(void);
+
+/*
+Handles an error on any core. On core0 it is exit_with_error(), on
+core1 the error is handed over to core0(core1_check()) and core1 
+stops, exit_with_error() must not run there.
+Parameters:
+- `error`: An error code defined in `error.h`.
+- `err_string`: A string that contains details about the error.
+*/
+void core_error(const int error, const char *err_string);
+
+#endif
@@ -16,21 +16,107 @@ are in crypto.c.
 #ifndef CRYPTO_H
 #define CRYPTO_H
 #include <stdint.h>
+#include <stddef.h>
+#include "monocypher.h"
+#include "parameters.h"
+
+/*
+State of one AEAD message decrypted in chunks(see aead_read_init()).
+*/
+struct aead_stream {
+ crypto_poly1305_ctx poly; // MAC of the received cipher text
+ uint8_t auth_key[64];     // Poly1305 key and next key of AEAD state
+ uint64_t counter;         // ChaCha20 block counter of the next chunk
+ size_t text_size;         // Amount of processed cipher text
+};
 
 /////////////////
 ///   PADME   ///
 /////////////////
+/*
+Macros for PADME of sizes known at compile time(constant expressions, 
+usable for array sizes), integer only:
+- PADME_LOG2: Floor of log2 of a constant from 0 to 2^32 - 1.
+- PADME_MASK: Bitmask of the size L, E = log2(L), S = log2(E) + 1,
+  the lowest E - S bits are masked.
+- PADME_SIZE: Same as padme_size(), PADME_ROUND: same as padme_round().
+*/
+#define PADME_LOG2_B2(x)  ((x) >= 2 ? 1 : 0)
+#define PADME_LOG2_B4(x)  ((x) >= 4 ? 2 + PADME_LOG2_B2((x) >> 2) : PADME_LOG2_B2(x))
+#define PADME_LOG2_B8(x)  ((x) >= 16 ? 4 + PADME_LOG2_B4((x) >> 4) : PADME_LOG2_B4(x))
+#define PADME_LOG2_B16(x) ((x) >= 256 ? 8 + PADME_LOG2_B8((x) >> 8) : PADME_LOG2_B8(x))
+#define PADME_LOG2(x) \
+  ((unsigned long)(x) >= 65536UL ? 16 + PADME_LOG2_B16((unsigned long)(x) >> 16) \
+                                 : PADME_LOG2_B16((unsigned long)(x)))
+/*E is at most 31, so log2(E) needs only 8 bits*/
+#define PADME_BITS(L) (PADME_LOG2(L) - PADME_LOG2_B8(PADME_LOG2(L)) - 1)
+#define PADME_MASK(L) (PADME_BITS(L) > 0 ? (1 << PADME_BITS(L)) - 1 : 0)
+#define PADME_SIZE(L) ((L) + PADME_MASK(L))
+#define PADME_ROUND(L) (((L) + PADME_MASK(L)) & ~PADME_MASK(L))
+
 /*
 This function derives the size of the padded array from the original
 message size. It implements the PADME algorithm without rounding
-using a bitmask (PADME: https://lbarman.ch/blog/padme/).
+using a bitmask (PADME: https://lbarman.ch/blog/padme/), for sizes
+known at compile time use PADME_SIZE().
 Parameters:
-- `L`: The size of the original message (L16, L24, or L32).
+- `L`: The size of the original message(any size from 1).
 Returns:
 - The size of the padded message.
 */
 int padme_size(const int L);
 
+/*
+This function rounds the size `L` up by the PADME algorithm, so only
+O(log log L) bits of the size are leaked(lengths of cipher text), 
+for sizes known at compile time use PADME_ROUND().
+Parameters:
+- `L`: The size of the original message(any size from 1).
+Returns:
+- The size of the padded message.
+*/
+int padme_round(const int L);
+
+/*
+Layout of messages in chat() padded by pad_message():
+- MESSAGE_OFFSET: Offset of the compressed text in the padded message.
+- MESSAGE_MAX: Size of the biggest padded message(buffers of
+  encrypted text).
+*/
+#if MESSAGE_PADDING == YES
+  #define MESSAGE_OFFSET BYTE_ARRAY_SZ
+  #define MESSAGE_MAX PADME_ROUND(BYTE_ARRAY_SZ + BUFF_MAX)
+#else
+  #define MESSAGE_OFFSET 0
+  #define MESSAGE_MAX BUFF_MAX
+#endif
+
+/*
+This function pads a compressed message before encryption
+(MESSAGE_PADDING in parameters.h). It writes the size of the text
+in front of it and zeros after it up to padme_round() of the whole
+message. Without padding the message stays unchanged.
+Parameters:
+- `message`: Buffer of MESSAGE_MAX bytes, the text is at MESSAGE_OFFSET.
+- `size`: Size of the text(up to BUFF_MAX).
+Returns:
+- The size of the padded message.
+*/
+uint32_t pad_message(uint8_t *message, const uint32_t size);
+
+/*
+Reverse of pad_message function, reads the size of the text from
+a decrypted message. The text stays at MESSAGE_OFFSET.
+Parameters:
+- `message`: Decrypted padded message.
+- `padded_size`: Size of the padded message.
+- `size`: Pointer where the size of the text will be stored.
+Returns:
+- OK if the size fits BUFF_MAX and the padding matches it,
+  otherwise RETURN_ERROR.
+*/
+int unpad_message(const uint8_t *message, const uint32_t padded_size, uint32_t *size);
+
 /*
 Padding of array (copying to an array of larger size 
 and the additional space is filled with random data).
@@ -95,5 +181,47 @@ void key_hidden(uint8_t *your_sk, uint8_t *your_pk, uint8_t *hidden, const int k
 /////////////////////////////////////////
 /////////////////////////////////////////
 
+/////////////////////////////////
+///   Streamed AEAD reading   ///
+/////////////////////////////////
+/*
+Starts decryption of one AEAD message that arrives in chunks.
+It computes the one-time Poly1305 key from the AEAD state `ctx` exactly
+like crypto_aead_read() does(no additional data is used).
+Parameters:
+- `stream`: A pointer to the state of the streamed message.
+- `ctx`: A pointer to the AEAD state(not changed until aead_read_final()).
+*/
+void aead_read_init(struct aead_stream *stream, const crypto_aead_ctx *ctx);
+
+/*
+Authenticates and decrypts the next chunk of the streamed message.
+Every chunk except the last one must be a multiple of 64 bytes(ChaCha20
+block), so the block counter continues without keeping the keystream.
+The plain text is written before the MAC is verified, so the caller must
+not use(and should wipe) it when aead_read_final() fails.
+Parameters:
+- `stream`: A pointer to the state of the streamed message.
+- `ctx`: A pointer to the AEAD state.
+- `plain_text`: A pointer to the buffer for decrypted chunk.
+- `cipher_text`: A pointer to the received chunk.
+- `size`: The size of the chunk.
+*/
+void aead_read_update(struct aead_stream *stream, const crypto_aead_ctx *ctx, uint8_t *plain_text, const uint8_t *cipher_text, const size_t size);
+
+/*
+Finishes the streamed message: compares the MAC with `mac` in constant time
+and on success re-keys the AEAD state `ctx` as crypto_aead_read() does.
+Parameters:
+- `stream`: A pointer to the state of the streamed message(wiped).
+- `ctx`: A pointer to the AEAD state.
+- `mac`: The received MAC of the message.
+Returns:
+- OK if the message is authentic, RETURN_ERROR otherwise.
+*/
+int aead_read_final(struct aead_stream *stream, crypto_aead_ctx *ctx, const uint8_t mac[16]);
+/////////////////////////////////
+/////////////////////////////////
+
 
 #endif
\ No newline at end of file
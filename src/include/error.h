@@ -16,6 +16,7 @@ that ends program and returns error code value
 */
 #ifndef ERROR_H
 #define ERROR_H
+#include <setjmp.h>
 
 //Defining errors with macros to use them in codes
 #define OK 0
@@ -75,4 +76,45 @@ void exit_with_error(const int error, const char *err_string);
 ///////////////////////////////////////
 /////////////////////////////////////// 
 
+///////////////////////////////////////
+/// Error Classes and Recovery      ///
+///////////////////////////////////////
+/*
+Classes of errors:
+- ERROR_CLASS_TRANSPORT: connection/network failures(socket creation,
+  connecting, receiving, sending, DHCP). The session can be repeated 
+  with the same network settings and XDRBG state.
+- ERROR_CLASS_FATAL: everything else(altered messages, illegitimate 
+  server, entropy/XDRBG, flash, memory, wrong input), chip is rebooted.
+*/
+#define ERROR_CLASS_FATAL 0
+#define ERROR_CLASS_TRANSPORT 1
+
+/*
+Returns the class of the error code `error`(ERROR_CLASS_*).
+*/
+int error_class(const int error);
+
+/*
+Recovery point of transport errors, defined in config.c.
+main() calls setjmp(error_recovery) and then recovery_arm(), 
+after that exit_with_error() does not reboot on transport errors, 
+but returns to this point(setjmp returns the error code).
+At most RECONNECT_COUNT transport errors in a row are recovered.
+*/
+extern jmp_buf error_recovery;
+
+/*
+Enables the recovery point(error_recovery must be set by setjmp).
+*/
+void recovery_arm(void);
+
+/*
+Disables the recovery point, after successful session also resets 
+the counter of recovered errors(`success` is YES).
+*/
+void recovery_disarm(const int success);
+///////////////////////////////////////
+/////////////////////////////////////// 
+
 #endif
@@ -34,4 +34,22 @@ void read_from_flash(const int offset, uint8_t *buffer, const int size);
 ///////////////////////
 ///////////////////////
 
+////////////////////////
+/// Flash Mem Writer ///
+////////////////////////
+/*
+This function replaces data in the key page(key, salt and Argon2i
+parameters), the rest of the first FLASH_PAGE_SIZE bytes is kept.
+Parameters:  
+- `offset` - the offset within the key page where the data is written.  
+- `buffer` - the data to write.  
+- `size` - the number of bytes to write(`offset` + `size` must not 
+  exceed FLASH_PAGE_SIZE).    
+The only key sector is erased and then programmed, a power loss between
+the two steps destroys the secured key(it must be written again).
+*/
+void write_to_flash(const int offset, const uint8_t *buffer, const int size);
+///////////////////////
+///////////////////////
+
 #endif
@@ -0,0 +1,30 @@
+// Client-server API(PICO)        //
+// Keccak 32-bit interleaved      //
+// Version 0.9.1pi                //
+// Bachelor's Work Project        //
+// Technical University of Kosice //
+// 17.10.2026                     //
+// Nikita Kuropatkin              //
+// Version for MCU                //
+// W5100S-EVB-Pico                //
+
+/*
+This header file declares Keccak-f[1600] for 32-bit processors
+(Cortex-M0+ has no 64-bit shifts or rotations). Lanes are split into 
+even and odd bits(bit interleaving), so the rotations of a 64-bit lane 
+are two 32-bit rotations. XDRBG uses it if KECCAK_BACKEND in 
+parameters.h selects it. Function body is in keccak_bi.c.
+*/
+#ifndef KECCAK_BI_H
+#define KECCAK_BI_H
+#include <stdint.h>
+
+/*
+Keccak-f[1600] on the state of 64-bit lanes(same input and output as
+keccakp_1600_64() in xdrbg.c), computed with 32-bit words only.
+Parameters:
+- `s`: State of 25 lanes, lane(x, y) is s[x + 5 * y].
+*/
+void keccakp_1600_bi(uint64_t s[25]);
+
+#endif
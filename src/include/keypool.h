@@ -0,0 +1,63 @@
+// Client-server API(PICO)        //
+// Keypair pool                   //
+// Version 0.9.1pi                //
+// Bachelor's Work Project        //
+// Technical University of Kosice //
+// 17.10.2026                     //
+// Nikita Kuropatkin              //
+// Version for MCU                //
+// W5100S-EVB-Pico                //
+
+/*
+This header file declares functions of the keypair pool. The second
+core(core1) of RP2040 generates SK, PK and Elligator hidden PK in advance
+(while the user goes through the menus or chats, see core1.c), so the key 
+exchange takes a ready keypair instead of looping in key_hidden().
+Function bodies are in keypool.c.
+Size of the pool is set by KEYPOOL_SIZE macro in parameters.h.
+*/
+#ifndef KEYPOOL_H
+#define KEYPOOL_H
+#include <stdint.h>
+#include "parameters.h"
+
+/*
+One precomputed keypair(only core1 writes it before it is published,
+only core0 reads and wipes it after that).
+*/
+struct keypool_entry {
+ uint8_t sk[KEYSZ];     // Secret key
+ uint8_t pk[KEYSZ];     // Public key
+ uint8_t hidden[KEYSZ]; // PK hidden with inverse mapping
+};
+
+/*
+Seeds XDRBG of the pool from XDRBG of the client(random_init() must be
+called first). Later calls do nothing. The pool is filled by core1
+(core1_start() in core1.c).
+*/
+void keypool_start(void);
+
+/*
+Generates one entry if the pool is not full. Runs on core1.
+Returns YES if an entry was generated, NO if the pool is full(or disabled).
+*/
+int keypool_fill(void);
+
+/*
+Takes one keypair from the pool and wipes its entry, core1 then 
+generates a new one. If the pool is empty(or disabled), the keypair is 
+generated on this core by key_hidden().
+Parameters:
+- `your_sk`: Output, secret key(KEYSZ bytes).
+- `your_pk`: Output, public key(KEYSZ bytes).
+- `hidden`: Output, PK hidden with inverse mapping(KEYSZ bytes).
+*/
+void keypool_take(uint8_t *your_sk, uint8_t *your_pk, uint8_t *hidden);
+
+/*
+Prints the counters of XDRBG of the pool since boot(core1 updates them).
+*/
+void keypool_stats(void);
+
+#endif
@@ -231,6 +231,15 @@ void  lzrw3a_compress(        /* Single function interface to compression algori
 
 uint32_t lzrw3a_req_mem();
 
+//#NK stream mode(the hash table is kept between blocks), see lzrw3-a.c
+void lzrw3a_stream_reset(UBYTE *wrk_mem);
+void lzrw3a_stream_compress(UBYTE *wrk_mem, UBYTE *src_adr, uint32_t src_len,
+                            UBYTE *dst_adr, uint32_t *p_dst_len);
+void lzrw3a_stream_decompress(UBYTE *wrk_mem, UBYTE *src_adr, uint32_t src_len,
+                              UBYTE *dst_adr, uint32_t dst_max, uint32_t *p_dst_len);
+void lzrw3a_stream_rebase(UBYTE *wrk_mem, UBYTE *p_first, uint32_t used, uint32_t delta);
+void lzrw3a_stream_prime(UBYTE *wrk_mem, UBYTE *p_dict, uint32_t dict_len);
+
 /******************************************************************************/
 /*                             End of COMPRESS.H                              */
 /******************************************************************************/
@@ -0,0 +1,87 @@
+// Client-server API(PICO)        //
+// LZRW3-A with 16-bit offsets    //
+// Version 0.9.1pi                //
+// Bachelor's Work Project        //
+// Technical University of Kosice //
+// 17.10.2026                     //
+// Nikita Kuropatkin              //
+// Version for MCU                //
+// W5100S-EVB-Pico                //
+
+/*
+This header file declares a variant of LZRW3-A whose hash table keeps
+16-bit offsets from the start of the block(or of the history before
+it) instead of pointers, so one entry takes 2 bytes instead of 4(8 on
+64-bit hosts). The table is sized at compile time for the longest
+block. With 4096 entries the output is the same as of LZRW3-A and the
+two can decompress each other. Function bodies are at the end of
+lzrw3-a.c.
+*/
+#ifndef LZRW3A16_H
+#define LZRW3A16_H
+#include <stdint.h>
+#include "parameters.h"
+
+/*
+Longest block the table must index: one message, with COMPRESS_STREAM
+also the history before it(all offsets are below 0xFFFF).
+*/
+#if COMPRESS_STREAM == YES
+  #define LZRW3A16_INPUT_MAX (COMPRESS_HISTORY + BUFF_MAX)
+#else
+  #define LZRW3A16_INPUT_MAX BUFF_MAX
+#endif
+
+/*
+log2 of entries of the hash table(partitions of 8 entries), about two
+entries for every position of the longest block, from 512 to 4096.
+With 12 bits(4096 entries) the output is the same as of LZRW3-A.
+*/
+#define LZRW3A16_TABLE_BITS \
+  (2 * (LZRW3A16_INPUT_MAX) > 2048 ? 12 : \
+   2 * (LZRW3A16_INPUT_MAX) > 1024 ? 11 : \
+   2 * (LZRW3A16_INPUT_MAX) > 512 ? 10 : 9)
+
+/*
+Work memory of a table with 2^`bits` entries.
+*/
+#define LZRW3A16_MEM(bits) ((1u << (bits)) * sizeof(uint16_t))
+
+_Static_assert(LZRW3A16_INPUT_MAX < 0xFFFF, "Offsets of LZRW3-A16 must fit 16 bits");
+
+/*
+The function points every entry of the table(2^`bits` entries, 9 to 12)
+in `wrk_mem` to the constant string of LZRW3-A.
+*/
+void lzrw3a16_init(uint8_t *wrk_mem, const int bits);
+
+/*
+The function compresses `src_len` bytes of `src` to `dst` like the
+stream mode of LZRW3-A(lzrw3a_stream_compress()), the table is kept
+for the next block.
+Parameters:
+- `wrk_mem`: Table of 2^`bits` entries(lzrw3a16_init()).
+- `bits`: log2 of entries of the table, 9 to 12.
+- `src`: Text to compress, `history` bytes of earlier blocks are right
+  before it in the same buffer.
+- `src_len`: Size of the text.
+- `dst`: Output of at most `src_len` + 1 + 2 * (`src_len` / 16 + 1) bytes.
+- `dst_len`: Pointer where the size of the output will be stored.
+- `history`: Bytes of history before `src`.
+*/
+void lzrw3a16_compress(uint8_t *wrk_mem, const int bits, uint8_t *src, uint32_t src_len, uint8_t *dst, uint32_t *dst_len, uint32_t history);
+
+/*
+Reverse of lzrw3a16_compress(), `dst` is right after `history` bytes
+of earlier blocks. At most `dst_max` bytes are written, if the output 
+does not fit or the input is broken, `dst_len` is set to UINT32_MAX.
+*/
+void lzrw3a16_decompress(uint8_t *wrk_mem, const int bits, uint8_t *src, uint32_t src_len, uint8_t *dst, uint32_t dst_max, uint32_t *dst_len, uint32_t history);
+
+/*
+The history has dropped its first `delta` bytes: offsets are moved by
+`delta`, the ones into the dropped part point to the constant string.
+*/
+void lzrw3a16_rebase(uint8_t *wrk_mem, const int bits, const uint32_t delta);
+
+#endif
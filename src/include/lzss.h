@@ -0,0 +1,87 @@
+// Client-server API(PICO)        //
+// LZSS compression               //
+// Version 0.9.1pi                //
+// Bachelor's Work Project        //
+// Technical University of Kosice //
+// 17.10.2026                     //
+// Nikita Kuropatkin              //
+// Version for MCU                //
+// W5100S-EVB-Pico                //
+
+/*
+This header file declares LZSS with a small window for short chat
+messages, a low RAM backend of compress_text()/decompress_text()
+(COMPRESS_BACKEND in parameters.h). Function bodies are in lzss.c.
+Format of the output:
+- header byte(COMPRESS_PACKED),
+- groups of a control byte and 8 items(bit 0 of the control byte is
+  the first item): 0 - literal byte, 1 - match of 2 bytes(big endian)
+  (offset - 1) << LZSS_LEN_BITS | (length - LZSS_MIN_MATCH).
+Matches can point up to LZSS_WINDOW bytes back, also into the history
+of earlier messages right before the block.
+*/
+#ifndef LZSS_H
+#define LZSS_H
+#include <stdint.h>
+
+/*
+Parameters of the format(both sides must use the same ones):
+- LZSS_WINDOW_BITS: log2 of the window, 8 to 10(256 to 1024 bytes),
+  offset and length share 16 bits.
+- LZSS_HASH_BITS: log2 of the heads of hash chains.
+- LZSS_DEPTH: The most of positions tried for every match(compressor
+  only, speed against ratio).
+*/
+#define LZSS_WINDOW_BITS 10
+#define LZSS_HASH_BITS 8
+#define LZSS_DEPTH 16
+
+#define LZSS_WINDOW (1 << LZSS_WINDOW_BITS)
+#define LZSS_LEN_BITS (16 - LZSS_WINDOW_BITS)
+#define LZSS_MIN_MATCH 3
+#define LZSS_MAX_MATCH (LZSS_MIN_MATCH + (1 << LZSS_LEN_BITS) - 1)
+
+/*
+Work memory of the compressor: heads of hash chains and previous
+position of every position in the window(16-bit positions).
+*/
+#define LZSS_MEM (((1 << LZSS_HASH_BITS) + LZSS_WINDOW) * sizeof(uint16_t))
+
+_Static_assert(LZSS_WINDOW_BITS >= 8 && LZSS_WINDOW_BITS <= 10, "LZSS window must be 256 to 1024 bytes");
+
+/*
+The function prepares the work memory `wrk_mem`(LZSS_MEM bytes) for
+a block without history.
+*/
+void lzss_init(uint8_t *wrk_mem);
+
+/*
+The function compresses `src_len` bytes of `src` to `dst`.
+Parameters:
+- `wrk_mem`: Work memory kept from the previous block(lzss_init()).
+- `src`: Text to compress, `history` bytes of earlier blocks are
+  right before it in the same buffer(at most 65535 - BUFF_MAX).
+- `src_len`: Size of the text.
+- `dst`: Output of at most `src_len` + 1 + `src_len` / 8 + 1 bytes.
+- `dst_len`: Pointer where the size of the output will be stored.
+- `history`: Bytes of history before `src`.
+*/
+void lzss_compress(uint8_t *wrk_mem, uint8_t *src, uint32_t src_len, uint8_t *dst, uint32_t *dst_len, uint32_t history);
+
+/*
+The function decompresses `src_len` bytes of `src` to at most `dst_max`
+bytes of `dst`, the work memory is not used. Matches can point into 
+`history` bytes before `dst`. If a match points before the history, 
+the output would not fit `dst_max` or the input ends inside of an 
+item, `dst_len` is set to UINT32_MAX.
+*/
+void lzss_decompress(uint8_t *wrk_mem, uint8_t *src, uint32_t src_len, uint8_t *dst, uint32_t dst_max, uint32_t *dst_len, uint32_t history);
+
+/*
+The history of `used` bytes at `first` has dropped its first `delta`
+bytes(moved to `first`). The hash chains are built again from the
+last LZSS_WINDOW bytes of what is left.
+*/
+void lzss_rebase(uint8_t *wrk_mem, uint8_t *first, uint32_t used, uint32_t delta);
+
+#endif
@@ -58,6 +58,26 @@ wiz_NetInfo choose_net_data(void);
 ///////////////////////////
 ///////////////////////////
 
+//////////////////////////
+/// DHCP Lease Renewal ///
+//////////////////////////
+/*
+Keeps the DHCP lease valid between sessions. Does nothing with static
+settings. The DHCP client keeps its socket open, DHCP_run() renews the
+lease when half of the lease time(counted by DHCP_time_handler()) passed.
+If the lease was lost, DHCP is started again.
+
+Takes as input parameter:
+  - net_info: The pointer to the network info of the session, updated
+    if the server assigned other settings.
+
+Returns YES if the settings changed(chip must be configured again), 
+otherwise NO.
+*/
+int dhcp_maintain(wiz_NetInfo *net_info);
+///////////////////////////
+///////////////////////////
+
 ///////////////////////////
 /// Read Network Input ///
 ///////////////////////////
@@ -56,6 +56,21 @@ is unlikely to exceed the 2^33-1 boundary.
 */
 #define BYTE_ARRAY_SZ 4
 
+/*
+In use: crypto.c, client.c.
+Enables(YES) or disables(NO) PADME padding of messages in chat().
+Encrypted text is then the size of the compressed text(BYTE_ARRAY_SZ
+bytes) || compressed text || zeros up to the PADME rounded size, so
+the size in the frame header leaks only O(log log L) bits of the
+message length. Zeros are encrypted like the text(AEAD key stream),
+no random data is needed. The server must use the same setting, it
+changes the frames of chat(). Disabled by default, a deployment opts in
+with YES here or by the compiler(-DMESSAGE_PADDING=YES).
+*/
+#ifndef MESSAGE_PADDING
+  #define MESSAGE_PADDING NO
+#endif
+
 /*
 In use: client.c; affects pin.c, crypto.c.
 These values define sizes for keys, nonces, and MACs. 
@@ -119,6 +134,69 @@ macro is necessary when using STATIC_STACK due to stack size limits.
 */
 #define ALLOCATION DYNAMIC  
 
+/*
+In use: compress_decompress.c.
+Selects the compressor of chat messages: LZRW3A(lzrw3-a.c, hash table 
+of 4096 pointers per direction, 16 KB on RP2040), LZRW3A16(same 
+algorithm with 16-bit offsets, table sized for the longest block: 8 KB 
+with COMPRESS_STREAM and the same output as LZRW3A, 2 KB without it) or 
+LZSS(lzss.c, 1 KB window, 2.5 KB for the compressor and nothing for the
+decompressor, aimed at short texts). bench_compress compares them on 
+host. The server must use the same backend. Can be set also by the compiler
+(-DCOMPRESS_BACKEND=LZSS).
+*/
+#ifndef COMPRESS_BACKEND
+  #define COMPRESS_BACKEND LZRW3A
+#endif
+
+/*
+In use: compress_decompress.c.
+Enables(YES) or disables(NO) streaming compression in chat(). Every 
+direction keeps the last messages of the session(history) and the work 
+memory of the backend, so a message can match earlier ones. The history 
+is reset for every new AEAD session(compress_init() after the key 
+exchange). Needs 2 * (work memory + COMPRESS_HISTORY + BUFF_MAX) bytes 
+instead of one work memory(LZRW3A: about 37 KB instead of 16 KB on 
+RP2040, LZSS: 10 KB instead of 2.5 KB). The server must use the same 
+setting. Disabled by default, a deployment opts in with YES here or by 
+the compiler(-DCOMPRESS_STREAM=YES).
+*/
+#ifndef COMPRESS_STREAM
+  #define COMPRESS_STREAM NO
+#endif
+
+/*
+In use: compress_decompress.c.
+Bytes of history kept for streaming compression(COMPRESS_STREAM). When
+the history is full, its older half is dropped. Can be modified, must be
+the same on both sides.
+*/
+#define COMPRESS_HISTORY 2048
+
+/*
+In use: compress_decompress.c.
+Texts shorter than COMPRESS_MIN bytes are sent stored(one byte header 
+and the text), LZRW3-A is not run for them on any side. Longer texts are 
+compressed and sent stored only if the compressed form is bigger. 
+Can be modified, must be the same on both sides.
+*/
+#define COMPRESS_MIN 12
+
+/*
+In use: compress_decompress.c.
+Dictionary mode of the LZRW3A backend. With YES the hash table of every
+block without history(every message without COMPRESS_STREAM, the start
+of the session with it) is primed with a dictionary of chat text built 
+from a sample corpus(compress_dict.c, made by dict_build). It stays 
+in flash(XIP), only the table points into it, so it takes no RAM. 
+Other backends ignore it. The server must use the same setting and 
+the same dictionary. Disabled by default, a deployment opts in with YES 
+here or by the compiler(-DCOMPRESS_DICT=YES).
+*/
+#ifndef COMPRESS_DICT
+  #define COMPRESS_DICT NO
+#endif
+
 /*
 In use: config.c.
 Enables or disables error printing. Set to NO to disable error 
@@ -131,6 +209,8 @@ In use: pin.c.
 Defines the number of memory blocks for Argon2i. The default value for Pico is 
 10 KB with 200 iterations. Adjusting this requires considering system RAM 
 and Argon2 input parameters.
+Used only if the key page holds no parameters stored by calibration
+("calibrate" at the end of a session, see ARGON2_TARGET_MS).
 */
 #define BLOCK_AMOUNT 10
 
@@ -139,9 +219,58 @@ In use: pin.c.
 Defines the number of iterations for Argon2i. The default is 200 iterations 
 with 10 KB of memory. Adjusting this requires considering system RAM 
 and Argon2 input parameters.
+Used only if the key page holds no parameters stored by calibration.
 */
 #define ITERATIONS 200
 
+/*
+In use: pin.c, argon2_lanes.c.
+Defines the number of lanes (parallelism) for Argon2i. With more than 
+one lane, core1 and core0 fill lanes at the same time(core0 joins when 
+the handshake waits for the key), so 2 lanes take about half of the time
+of 1 lane with the same BLOCK_AMOUNT and ITERATIONS.
+BLOCK_AMOUNT must be at least 8 * LANSES.
+Changing this value changes the hash of the PIN, the key in flash must be
+secured again with the same value(flash_key_salt program, bench server).
+*/
+#define LANSES 1
+
+/*
+In use: pin.c.
+Target time of one PIN unlock(Argon2i on core0 alone) in milliseconds
+for calibration. Typing "calibrate" at the end of a session measures 
+Argon2i on the running board(clock, flash, RAM as they are) and picks 
+the largest number of blocks(up to ARGON2_MAX_BLOCKS) with at least
+ARGON2_MIN_PASSES passes, then the most passes that fit into this time.
+*/
+#define ARGON2_TARGET_MS 500
+
+/*
+In use: pin.c.
+Upper limit of Argon2i memory in KB for calibration. With STATIC_BSS or 
+STATIC_STACK allocation the work area has BLOCK_AMOUNT KB, so BLOCK_AMOUNT 
+is the limit instead.
+*/
+#define ARGON2_MAX_BLOCKS 64
+
+/*
+In use: pin.c.
+Lowest number of Argon2i passes calibration accepts, memory is lowered
+until this number of passes fits into ARGON2_TARGET_MS(Argon2i needs at
+least 3 passes over small memory).
+*/
+#define ARGON2_MIN_PASSES 3
+
+/*
+In use: pin.c.
+Idle timeout in seconds of the unlocked key cache. After a session ended
+normally, the unlocked key is kept in RAM(XORed with a random mask made
+once per boot), so the next session started within this time skips the
+PIN prompt and Argon2i. The key is wiped after the timeout, on any error
+and on calibration. Set to 0 to disable the cache(PIN for every session).
+*/
+#define KEY_CACHE_TIMEOUT 0
+
 /*
 In use: pin.c.
 Defines the PIN size. Changing this requires reapplying a new PIN to 
@@ -176,6 +305,30 @@ but it is not recommended.
 */
 #define SEED_SIZE 64
 
+/*
+In use: random.c.
+Enables(YES) or disables(NO) the pool of XDRBG output. Every generate call
+of XDRBG squeezes a new 64-byte V before the output, so small requests 
+(tweak, SK, padding, nonce) pay a Keccak-f[1600] permutation each. 
+With the pool, random_num() serves them from RANDOM_POOL_SIZE bytes 
+generated at once. Bytes in the pool are secret until served and wiped.
+*/
+#define RANDOM_POOL YES
+
+/*
+In use: xdrbg.c.
+Selects the Keccak-f[1600] permutation of XDRBG: KECCAK_64(original code
+with 64-bit lanes), KECCAK_32BI(32-bit bit-interleaved lanes, keccak_bi.c,
+no 64-bit rotations) or KECCAK_AUTO(KECCAK_32BI on 32-bit targets like
+Cortex-M0+, KECCAK_64 otherwise). Both give the same output.
+With KECCAK_AUTO the board runs keccak_bi.c and the 64-bit host keeps 
+the original code. Can be set also by the compiler
+(-DKECCAK_BACKEND=KECCAK_32BI) to test the 32-bit backend on host.
+*/
+#ifndef KECCAK_BACKEND
+  #define KECCAK_BACKEND KECCAK_AUTO
+#endif
+
 /*
 Used in: client.c  
 This macro sets the communication type between the host computer 
@@ -205,16 +358,6 @@ conflict with a value from SOCKET_NUM.
 */
 #define SOCKET_DHCP 3
 
-/*
-In use: client.c.
-This macro defines how many times the firmware will execute  
-without a full system reboot (saving some time).  
-Due to the design of some functions, 
-you should not set this value greater than 6.  
-The value must also be greater than 0.  
-*/
-#define LIVE_COUNT 6
-
 /*
 In use: network_data.c.  
 Calculates the start of the second-to-last flash memory sector.  
@@ -237,6 +380,96 @@ to access the right values from it.
 */
 #define FLASH_PAGE_SERPORT (PICO_FLASH_SIZE_BYTES - 3 * FLASH_SECTOR_SIZE)
 
+/*
+In use: client.c.
+Defines the chat mode. TURNS: the user writes one message and the client 
+waits for exactly one reply(strict ping-pong, as in older versions).
+DUPLEX: the client polls stdin and the socket in one loop, so messages 
+can be sent and received at any time and in any amount.
+Both modes use the same frames, so the server does not need changes.
+Can be also set by a compiler definition(host build does it for 
+client_pico_duplex).
+*/
+#ifndef CHAT_MODE
+  #define CHAT_MODE TURNS
+#endif
+
+/*
+In use: client.c, crypto.c.
+Defines the size of chunks(in bytes) in which the received encrypted text
+is read from the socket and decrypted, so the whole encrypted message 
+is never stored. Must be a multiple of 64(ChaCha20 block). 
+Bigger values mean fewer recv() calls, smaller values less stack.
+*/
+#define AEAD_CHUNK 128
+
+/*
+In use: config.c, client.c.
+Defines how many transport errors(lost connection, failed connect,
+DHCP failure) in a row are recovered by reconnecting to the server
+without reboot. Next error reboots the chip. RECONNECT_DELAY is the 
+pause(ms) before reconnecting. Value 0 means reboot on every error.
+*/
+#define RECONNECT_COUNT 5
+#define RECONNECT_DELAY 1000
+
+/*
+In use: client.c.
+Size of the stack area(bytes) wiped after recovery from a transport error,
+it must cover frames of key_exc_ell(), chat() and functions called by them.
+With STATIC_STACK allocation client.c adds sizeof(struct compress_ctx),
+the work memory of the compressor is in the frame of chat().
+*/
+#define STACK_WIPE_SIZE (2 * BUFF_MAX + 3 * TEXT_MAX + 2048)
+
+/*
+In use: network.c.
+Deadline(ms) of one read_pico()/write_pico() call. A write must move
+all bytes in this time, a read must get the rest of the data in this time
+after the first byte arrived(waiting for the first byte is not limited, 
+because on the other side the user can be typing the reply).
+You can modify this value, but it should stay above a few hundred ms.
+NET_POLL_US is the pause(us) between two polls of an idle socket, so
+the waiting loops do not spin the CPU.
+*/
+#define NET_TIMEOUT (1000 * 10)
+#define NET_POLL_US 20
+
+/*
+In use: trace.c, client.c, crypto.c, network.c, random.c, pin.c,
+compress_decompress.c.
+Enables or disables phase tracing. Set to YES to record begin/end
+timestamps(microseconds) of the client phases into a ring buffer, 
+or NO to compile all tracing out. The ring is printed as CSV if the user
+types "trace" when the program asks to press Enter after the session.
+*/
+#define TRACE YES
+
+/*
+In use: trace.c.
+Defines the number of entries in the trace ring buffer(12 bytes each).
+When the ring is full, the oldest entries are overwritten.
+The value must be a power of two.
+*/
+#define TRACE_SIZE 128
+
+/*
+In use: keypool.c.
+Defines the number of precomputed keypairs(SK, PK, hidden PK; 96 bytes 
+each) that the second core keeps ready for the key exchange.
+The value must be a power of two. Set to 0 to disable the pool, 
+the keypair is then generated on the first core during the handshake.
+*/
+#define KEYPOOL_SIZE 4
+
+/*
+In use: core1.c.
+Defines the size of the second core`s stack in bytes. Core1 runs
+X25519 with Elligator inverse map(about 1.5 KB) and Argon2i of the PIN
+(about 2 KB, plus BLOCK_AMOUNT KB if ALLOCATION is STATIC_STACK).
+*/
+#define CORE1_STACK_SIZE (1024 * 8)
+
 
 /////////////////// 
 /* Do not modify */ 
@@ -295,7 +528,7 @@ Do not change this value!
 #define MAC_OFFSET 16
 
 /*
-In use: network_data.c
+In use: network_data.c, client.c
 Macro defining sizes of IP, default gateway, subnet mask, DNS, 
 that are stored in struct wiz_NetInfo.
 Do not change this value!
@@ -357,6 +590,14 @@ Do not change these values!
 #define UART 0
 #define USB 1
 
+/*
+In use: client.c
+Macros defining the available chat modes(CHAT_MODE macro).
+Do not change these values!
+*/
+#define TURNS 0
+#define DUPLEX 1
+
 /*
 In use: addition.c
 The next two macros define the allowed range 
@@ -378,6 +619,23 @@ which is why they are here. (I do not recommend changing them.)
 #define STATIC_STACK 1  // Memory will be allocated statically on the stack
 #define DYNAMIC 2       // Memory will be allocated dynamically on the heap
 
+/*
+In use: here (upper segment -> macro KECCAK_BACKEND), xdrbg.c
+Options of the Keccak-f[1600] backend of XDRBG.
+*/
+#define KECCAK_64 0    // Original code, 64-bit lanes
+#define KECCAK_32BI 1  // 32-bit bit-interleaved lanes(keccak_bi.c)
+#define KECCAK_AUTO 2  // KECCAK_32BI on 32-bit targets, else KECCAK_64
+
+/*
+In use: here (upper segment -> macro COMPRESS_BACKEND), 
+compress_decompress.c
+Options of the compressor backend.
+*/
+#define LZRW3A 0  // LZRW3-A(lzrw3-a.c)
+#define LZSS 1    // LZSS with a small window(lzss.c)
+#define LZRW3A16 2  // LZRW3-A with 16-bit offsets(lzrw3a16.h)
+
 /*
 In use: here (upper segment -> macro DEBUG), config.c, client.c, addition.c
 Two macros define DEBUG macro options. 
@@ -423,14 +681,6 @@ Do not change this value!
 */
 #define HASHSZ KEYSZ 
 
-/*
-In use: pin.c.
-Defines the number of threads (parallelism) for Argon2i.  
-Since Monocypher uses a single-threaded approach, 
-this value does not need to be changed.
-*/
-#define LANSES 1
-
 /*
 In use: pin.c.
 Specifies the offset (starting location) of the secured key in flash memory.  
@@ -449,6 +699,31 @@ to store it elsewhere.
 */
 #define SALT_OFFSET KEYSZ
 
+/*
+In use: pin.c.
+Specifies the offset of Argon2i parameters stored by calibration in flash 
+memory, they are stored after the salt: ARGON2_PARAMS_MAGIC, then number 
+of blocks, passes and lanes(32-bit little-endian each). 
+An erased page(flash_key_salt program) has no magic, BLOCK_AMOUNT, 
+ITERATIONS and LANSES are used then.
+Do not change this value!
+*/
+#define PARAMS_OFFSET (SALT_OFFSET + SALTSZ)
+#define PARAMS_SIZE 16
+#define ARGON2_PARAMS_MAGIC 0x69324741 // "AG2i" in little-endian
+
+/*
+In use: random.c.
+RANDOM_RATE is the rate(block) of SHAKE256 in bytes, RANDOM_CHUNK is 
+the maximum output of XDRBG per V update(two blocks). The pool takes
+the rest of two blocks after V, so one refill costs two permutations,
+the same as one request of 73 to 208 bytes.
+Do not change these values!
+*/
+#define RANDOM_RATE 136
+#define RANDOM_CHUNK (2 * RANDOM_RATE)
+#define RANDOM_POOL_SIZE (2 * RANDOM_RATE - LC_XDRBG256_DRNG_KEYSIZE)
+
 /*
 In use: flash_reader.c.
 Calculates the start of the last flash memory sector.  
@@ -16,6 +16,68 @@ are in random.c.
 #ifndef RANDOM_H
 #define RANDOM_H
 #include <stdint.h>
+#include <stddef.h>
+#include "xdrbg.h"
+#include "parameters.h"
+
+/*
+Pool of XDRBG output in front of lc_xdrbg256_drng_generate().
+- drbg: Working state of XDRBG.
+- bytes: Generated bytes, the first `left` of them are not served yet.
+- requests, permutations, permutations_direct: Counters of requests, 
+  Keccak-f[1600] permutations done and permutations without the pool.
+*/
+struct random_pool {
+    struct lc_xdrbg256_drng_state drbg;
+    uint8_t bytes[RANDOM_POOL_SIZE];
+    uint32_t left;
+    uint32_t requests;
+    uint32_t permutations;
+    uint32_t permutations_direct;
+};
+
+/*
+Function: random_pool_seed
+Purpose: Seeds XDRBG of the pool, bytes left in the pool are wiped.
+Input:
+    - pool: Pointer to the pool.
+    - seed: Pointer to the entropy data used for seeding.
+    - size: Length of the seed data in bytes.
+Output:
+    - Returns OK on success, or a non-zero value on failure.
+*/
+int random_pool_seed(struct random_pool *pool, uint8_t *seed, const size_t size);
+
+/*
+Function: random_pool_generate
+Purpose: Fills `out` with random bytes of XDRBG, requests up to 
+RANDOM_POOL_SIZE bytes are served from the pool(RANDOM_POOL), 
+served bytes are wiped.
+Input:
+    - pool: Pointer to the pool.
+    - out: Pointer to the output buffer.
+    - size: The number of random bytes.
+Output:
+    - Returns OK on success, or a non-zero value on failure.
+*/
+int random_pool_generate(struct random_pool *pool, uint8_t *out, size_t size);
+
+/*
+Function: random_pool_stats
+Purpose: Prints the counters of the pool as a comment line of the trace CSV.
+Input:
+    - pool: Pointer to the pool.
+    - name: Name of the pool in the output.
+*/
+void random_pool_stats(const struct random_pool *pool, const char *name);
+
+/*
+Function: random_pool_reset_stats
+Purpose: Sets the counters of the pool to zero.
+Input:
+    - pool: Pointer to the pool.
+*/
+void random_pool_reset_stats(struct random_pool *pool);
 
 /*
 Function: random_num
@@ -28,6 +90,19 @@ Input:
 */
 void random_num(uint8_t *number,const int size);
 
+/*
+Function: random_stats
+Purpose: Prints the counters of random_num() since the last 
+random_stats_reset()(one session).
+*/
+void random_stats(void);
+
+/*
+Function: random_stats_reset
+Purpose: Sets the counters of random_num() to zero.
+*/
+void random_stats_reset(void);
+
 /*
 Function: random_init
 Purpose: Initializes the random number generator by seeding the 
@@ -29,6 +29,8 @@ void set_clock_khz(void);
 
 /*
 Function that repeatedly increments the counter every millisecond.
+Every second it also ticks the DHCP client, its timeouts and
+the lease renewal are counted in seconds by DHCP_time_handler().
 */
 void repeating_timer_callback(void);
 
@@ -0,0 +1,101 @@
+// Client-server API(PICO)        //
+// Phase tracing                  //
+// Version 0.9.1pi                //
+// Bachelor's Work Project        //
+// Technical University of Kosice //
+// 17.10.2026                     //
+// Nikita Kuropatkin              //
+// Version for MCU                //
+// W5100S-EVB-Pico                //
+
+/*
+This header file declares functions and macros for tracing of the client
+phases(key generation, PIN hashing, KDF, socket I/O, compression, AEAD).
+Every phase writes begin/end timestamps into statically allocated
+ring buffer, nothing is printed on the hot path. The ring is printed
+as CSV after the session by trace_dump().
+Function bodies are in trace.c.
+Tracing is turned on/off by TRACE macro in parameters.h.
+*/
+#ifndef TRACE_H
+#define TRACE_H
+#include <stdint.h>
+#include "parameters.h"
+
+/*
+Traced phases of the client, index to the names in trace.c.
+*/
+enum trace_phase {
+ TRACE_RANDOM_INIT = 0, // Seeding of XDRBG(random_init)
+ TRACE_CONNECT,         // Connecting to the server(sockct_opn)
+ TRACE_KEY_HIDDEN,      // SK + hidden PK generation, arg = rejections
+ TRACE_KEY_POOL,        // Keypair taken from the pool, arg = entries left
+ TRACE_PIN_CHECKER,     // Typing of PIN and its format check
+ TRACE_HASHING_PIN,     // Argon2i hashing of the PIN(on core1)
+ TRACE_PIN_WAIT,        // Handshake waits for the unlocked key
+ TRACE_KDF,             // x25519 + Blake2b key derivation
+ TRACE_READ,            // read_pico, arg = size
+ TRACE_WRITE,           // write_pico, arg = size
+ TRACE_COMPRESS,        // compress_text, arg = compressed size
+ TRACE_AEAD_WRITE,      // crypto_aead_write, arg = size
+ TRACE_AEAD_READ,       // crypto_aead_read, arg = size
+ TRACE_DECOMPRESS,      // decompress_text, arg = compressed size
+ TRACE_PHASES           // Amount of phases
+};
+
+/*
+One record of the ring buffer(12 bytes).
+Timestamps are from the 32-bit microsecond timer, so the difference
+is valid also after the wrap of the timer(~71 minutes).
+*/
+struct trace_entry {
+ uint32_t begin_us; // Timestamp of the phase start
+ uint32_t end_us;   // Timestamp of the phase end
+ uint16_t arg;      // Phase argument(size, iteration count)
+ uint8_t phase;     // Value from enum trace_phase
+ uint8_t reserved;  // Alignment
+};
+
+/*
+Returns the current value of the microsecond timer(time_us_32()).
+*/
+uint32_t trace_now(void);
+
+/*
+Stores one phase into the ring buffer, overwrites the oldest entry if
+the ring is full. Does not print anything.
+Parameters:
+- `phase`: Value from enum trace_phase.
+- `begin_us`: Timestamp taken by trace_now() at the start of the phase.
+- `arg`: Phase argument(size of data, count of iterations),
+  values bigger than 65535 are saturated.
+*/
+void trace_record(const uint8_t phase, const uint32_t begin_us, const uint32_t arg);
+
+/*
+Clears the ring buffer, called at the beginning of every session.
+*/
+void trace_reset(void);
+
+/*
+Prints the ring buffer as CSV(oldest entry first) to stdout:
+seq,phase,begin_us,end_us,duration_us,arg
+Times are relative to the first stored entry.
+*/
+void trace_dump(void);
+
+/*
+Macros used in the traced code, so there is no trace code
+in the firmware when TRACE is set to NO.
+TRACE_BEGIN(var) declares `var` with start timestamp of the phase,
+TRACE_END(phase, var, arg) records the phase.
+*/
+#if TRACE == YES
+  #define TRACE_BEGIN(var) uint32_t var = trace_now()
+  #define TRACE_END(phase, var, arg) trace_record((phase), (var), (arg))
+#else
+  #define TRACE_BEGIN(var)
+  #define TRACE_END(phase, var, arg)
+#endif
+
+#endif
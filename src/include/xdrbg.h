@@ -61,4 +61,13 @@ int lc_xdrbg256_drng_generate(struct lc_xdrbg256_drng_state *state,
                                uint8_t *out, size_t outlen
                              );
 
+/*
+Function: keccakp_1600_64
+Purpose: Keccak-f[1600] permutation of the original code(64-bit lanes),
+         exported for the comparison with keccakp_1600_bi() in bench_crypto.
+Input:
+    - s: State of 25 lanes, lane(x, y) is s[x + 5 * y].
+*/
+void keccakp_1600_64(uint64_t s[25]);
+
 #endif
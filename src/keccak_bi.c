@@ -0,0 +1,183 @@
+// Client-server API(PICO)        //
+// Keccak 32-bit interleaved      //
+// Version 0.9.1pi                //
+// Bachelor's Work Project        //
+// Technical University of Kosice //
+// 17.10.2026                     //
+// Nikita Kuropatkin              //
+// Version for MCU                //
+// W5100S-EVB-Pico                //
+
+#include <stdint.h>
+#include "include/keccak_bi.h"
+#include "include/monocypher.h" //crypto_wipe()
+
+/*
+Lane(x, y) of the state is s[x + 5 * y], as in xdrbg.c.
+Every 64-bit lane is kept as two 32-bit words: `even` has bits 0, 2, ..., 62
+and `odd` has bits 1, 3, ..., 63 of the lane. A 64-bit rotation by `r` is
+then two 32-bit rotations(RORS on Cortex-M0+) by r/2, for odd `r` the words
+swap places.
+*/
+
+/*
+Rotation offsets of rho for lane x + 5 * y.
+*/
+static const uint8_t keccak_bi_rho[25] = {
+	 0,  1, 62, 28, 27,
+	36, 44,  6, 55, 20,
+	 3, 10, 43, 25, 39,
+	41, 45, 15, 21,  8,
+	18,  2, 61, 56, 14
+};
+
+/*
+Destination of lane x + 5 * y by pi: lane y + 5 * ((2x + 3y) % 5).
+*/
+static const uint8_t keccak_bi_pi[25] = {
+	 0, 10, 20,  5, 15,
+	16,  1, 11, 21,  6,
+	 7, 17,  2, 12, 22,
+	23,  8, 18,  3, 13,
+	14, 24,  9, 19,  4
+};
+
+/*
+Columns x + 1 and x - 1 modulo 5 for theta and chi, Cortex-M0+ has no 
+divide instruction(% 5 would be a library call).
+*/
+static const uint8_t keccak_bi_next[5] = { 1, 2, 3, 4, 0 };
+static const uint8_t keccak_bi_prev[5] = { 4, 0, 1, 2, 3 };
+
+/*
+Round constants of iota in interleaved form {even, odd}.
+*/
+static const uint32_t keccak_bi_iota[24][2] = {
+	{ 0x00000001U, 0x00000000U }, { 0x00000000U, 0x00000089U }, { 0x00000000U, 0x8000008bU },
+	{ 0x00000000U, 0x80008080U }, { 0x00000001U, 0x0000008bU }, { 0x00000001U, 0x00008000U },
+	{ 0x00000001U, 0x80008088U }, { 0x00000001U, 0x80000082U }, { 0x00000000U, 0x0000000bU },
+	{ 0x00000000U, 0x0000000aU }, { 0x00000001U, 0x00008082U }, { 0x00000000U, 0x00008003U },
+	{ 0x00000001U, 0x0000808bU }, { 0x00000001U, 0x8000000bU }, { 0x00000001U, 0x8000008aU },
+	{ 0x00000001U, 0x80000081U }, { 0x00000000U, 0x80000081U }, { 0x00000000U, 0x80000008U },
+	{ 0x00000000U, 0x00000083U }, { 0x00000000U, 0x80008003U }, { 0x00000001U, 0x80008088U },
+	{ 0x00000000U, 0x80000088U }, { 0x00000001U, 0x00008000U }, { 0x00000000U, 0x80008082U }
+};
+
+/*
+32-bit rotation, `n` from 0 to 31.
+*/
+static inline uint32_t rol32(const uint32_t x, const unsigned int n)
+{
+	return (x << n) | (x >> ((32 - n) & 31));
+}
+
+/*
+Moves even bits of `x` to the low half and odd bits to the high half
+(the inverse is keccak_bi_unshuffle()).
+*/
+static inline uint32_t keccak_bi_shuffle(uint32_t x)
+{
+	uint32_t t;
+	t = (x ^ (x >> 1)) & 0x22222222U; x ^= t ^ (t << 1);
+	t = (x ^ (x >> 2)) & 0x0C0C0C0CU; x ^= t ^ (t << 2);
+	t = (x ^ (x >> 4)) & 0x00F000F0U; x ^= t ^ (t << 4);
+	t = (x ^ (x >> 8)) & 0x0000FF00U; x ^= t ^ (t << 8);
+	return x;
+}
+
+static inline uint32_t keccak_bi_unshuffle(uint32_t x)
+{
+	uint32_t t;
+	t = (x ^ (x >> 8)) & 0x0000FF00U; x ^= t ^ (t << 8);
+	t = (x ^ (x >> 4)) & 0x00F000F0U; x ^= t ^ (t << 4);
+	t = (x ^ (x >> 2)) & 0x0C0C0C0CU; x ^= t ^ (t << 2);
+	t = (x ^ (x >> 1)) & 0x22222222U; x ^= t ^ (t << 1);
+	return x;
+}
+
+/*
+Converts 64-bit lanes to the interleaved words and back.
+*/
+static void keccak_bi_to(const uint64_t s[25], uint32_t even[25], uint32_t odd[25])
+{
+	for (unsigned int i = 0; i < 25; i++) {
+		uint32_t lo = keccak_bi_shuffle((uint32_t)s[i]);
+		uint32_t hi = keccak_bi_shuffle((uint32_t)(s[i] >> 32));
+		even[i] = (lo & 0x0000FFFFU) | (hi << 16);
+		odd[i]  = (lo >> 16) | (hi & 0xFFFF0000U);
+	}
+}
+
+static void keccak_bi_from(uint64_t s[25], const uint32_t even[25], const uint32_t odd[25])
+{
+	for (unsigned int i = 0; i < 25; i++) {
+		uint32_t lo = keccak_bi_unshuffle((even[i] & 0x0000FFFFU) | (odd[i] << 16));
+		uint32_t hi = keccak_bi_unshuffle((even[i] >> 16) | (odd[i] & 0xFFFF0000U));
+		s[i] = (uint64_t)lo | ((uint64_t)hi << 32);
+	}
+}
+
+/*
+Keccak-f[1600] on the state of 64-bit lanes(same input and output as
+keccakp_1600() in xdrbg.c), computed with 32-bit words only.
+Parameters:
+- `s`: State of 25 lanes, lane(x, y) is s[x + 5 * y].
+*/
+void keccakp_1600_bi(uint64_t s[25])
+{
+	uint32_t e[25], o[25];   // State
+	uint32_t be[25], bo[25]; // State after rho and pi
+	uint32_t ce[5], co[5];   // Parities of columns
+
+	keccak_bi_to(s, e, o);
+
+	for (unsigned int round = 0; round < 24; round++) {
+		/* theta */
+		for (unsigned int x = 0; x < 5; x++) {
+			ce[x] = e[x] ^ e[x + 5] ^ e[x + 10] ^ e[x + 15] ^ e[x + 20];
+			co[x] = o[x] ^ o[x + 5] ^ o[x + 10] ^ o[x + 15] ^ o[x + 20];
+		}
+		for (unsigned int x = 0; x < 5; x++) {
+			/* D = C[x - 1] ^ rol64(C[x + 1], 1) */
+			uint32_t de = ce[keccak_bi_prev[x]] ^ rol32(co[keccak_bi_next[x]], 1);
+			uint32_t d_o = co[keccak_bi_prev[x]] ^ ce[keccak_bi_next[x]];
+			for (unsigned int y = 0; y < 25; y += 5) {
+				e[x + y] ^= de;
+				o[x + y] ^= d_o;
+			}
+		}
+
+		/* rho and pi */
+		for (unsigned int i = 0; i < 25; i++) {
+			unsigned int r = keccak_bi_rho[i];
+			unsigned int to = keccak_bi_pi[i];
+			if (r & 1) {
+				be[to] = rol32(o[i], ((r + 1) / 2) & 31);
+				bo[to] = rol32(e[i], (r - 1) / 2);
+			}
+			else {
+				be[to] = rol32(e[i], r / 2);
+				bo[to] = rol32(o[i], r / 2);
+			}
+		}
+
+		/* chi */
+		for (unsigned int y = 0; y < 25; y += 5) {
+			for (unsigned int x = 0; x < 5; x++) {
+				unsigned int x1 = keccak_bi_next[x], x2 = keccak_bi_next[x1];
+				e[x + y] = be[x + y] ^ (~be[x1 + y] & be[x2 + y]);
+				o[x + y] = bo[x + y] ^ (~bo[x1 + y] & bo[x2 + y]);
+			}
+		}
+
+		/* iota */
+		e[0] ^= keccak_bi_iota[round][0];
+		o[0] ^= keccak_bi_iota[round][1];
+	}
+
+	keccak_bi_from(s, e, o);
+	crypto_wipe(e, sizeof(e)); // Copies of the DRBG state
+	crypto_wipe(o, sizeof(o));
+	crypto_wipe(be, sizeof(be));
+	crypto_wipe(bo, sizeof(bo));
+}
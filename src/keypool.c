@@ -0,0 +1,160 @@
+// Client-server API(PICO)        //
+// Keypair pool                   //
+// Version 0.9.1pi                //
+// Bachelor's Work Project        //
+// Technical University of Kosice //
+// 17.10.2026                     //
+// Nikita Kuropatkin              //
+// Version for MCU                //
+// W5100S-EVB-Pico                //
+
+#include <string.h>
+#include "include/keypool.h"
+#include "include/core1.h" //core_error()
+#include "include/crypto.h" //key_hidden()
+#include "include/random.h" //CSPRNG
+#include "include/error.h"
+#include "include/monocypher.h"
+#include "include/parameters.h" //Macros are defined here
+#include "include/xdrbg.h"
+#include "include/trace.h"
+#include "hardware/sync.h"
+
+#if KEYPOOL_SIZE > 0
+
+#if (KEYPOOL_SIZE & (KEYPOOL_SIZE - 1)) != 0
+  #error "KEYPOOL_SIZE must be a power of two"
+#endif
+
+/*
+Ring of precomputed keypairs. Core1 is the only writer of `keypool_head`
+(count of generated entries), core0 is the only writer of `keypool_tail`
+(count of taken entries), so no lock is needed. Entries between tail and
+head are ready.
+*/
+static struct keypool_entry keypool[KEYPOOL_SIZE];
+static volatile uint32_t keypool_head = 0;
+static volatile uint32_t keypool_tail = 0;
+static int keypool_running = NO;
+
+/*
+Working state of XDRBG with its pool used only by core1, so the XDRBG 
+of the client is never called from two cores at once.
+*/
+static struct random_pool keypool_drbg = { 0 };
+
+/////////////////////////
+///   Pool generator  ///
+/////////////////////////
+/*
+Generates one keypair with XDRBG of the pool, same loop as key_hidden().
+Runs on core1.
+Parameters:
+- `entry`: The pointer to the entry to fill.
+*/
+static void keypool_generate(struct keypool_entry *entry)
+{
+ uint8_t tweak; // Tweak for elligator`s inverse map
+ if (random_pool_generate(&keypool_drbg, &tweak, 1) != OK) {
+    core_error(ERROR_GENERATING_RANDOM, "Error generating random bits");
+ }
+
+ while (1) {
+    if (random_pool_generate(&keypool_drbg, entry->sk, KEYSZ) != OK) {
+       core_error(ERROR_GENERATING_RANDOM, "Error generating random bits");
+    }
+    crypto_x25519_dirty_fast(entry->pk, entry->sk);
+    if (crypto_elligator_rev(entry->hidden, entry->pk, tweak) == OK)
+       break;
+ }
+ crypto_wipe(&tweak, 1);
+}
+/////////////////////////
+/////////////////////////
+#endif
+
+/////////////////////////
+///   Pool interface  ///
+/////////////////////////
+/*
+Seeds XDRBG of the pool from XDRBG of the client(random_init() must be
+called first). Later calls do nothing. The pool is filled by core1
+(core1_start() in core1.c).
+*/
+void keypool_start(void)
+{
+#if KEYPOOL_SIZE > 0
+ if (keypool_running == YES) {
+    return;
+ }
+
+ uint8_t seed[SEED_SIZE];
+ random_num(seed, SEED_SIZE);
+ if (random_pool_seed(&keypool_drbg, seed, sizeof(seed)) != OK) {
+    exit_with_error(ERROR_SEEDING_XDRBG, "Error seeding XDRBG");
+ }
+ crypto_wipe(seed, SEED_SIZE); //Wiping seed after seeding the XDRBG
+
+ keypool_running = YES;
+#endif
+}
+
+/*
+Generates one entry if the pool is not full. Runs on core1.
+Returns YES if an entry was generated, NO if the pool is full(or disabled).
+*/
+int keypool_fill(void)
+{
+#if KEYPOOL_SIZE > 0
+ if (keypool_running == YES && keypool_head - keypool_tail < KEYPOOL_SIZE) {
+    keypool_generate(&keypool[keypool_head & (KEYPOOL_SIZE - 1)]);
+    __dmb(); // Entry is written before it is published
+    keypool_head++;
+    return YES;
+ }
+#endif
+ return NO;
+}
+
+/*
+Takes one keypair from the pool and wipes its entry, core1 then
+generates a new one. If the pool is empty(or disabled), the keypair is
+generated on this core by key_hidden().
+Parameters:
+- `your_sk`: Output, secret key(KEYSZ bytes).
+- `your_pk`: Output, public key(KEYSZ bytes).
+- `hidden`: Output, PK hidden with inverse mapping(KEYSZ bytes).
+*/
+void keypool_take(uint8_t *your_sk, uint8_t *your_pk, uint8_t *hidden)
+{
+#if KEYPOOL_SIZE > 0
+ TRACE_BEGIN(trace_begin);
+ core1_check(); // Core1 may have stopped with an error
+ if (keypool_running == YES && keypool_head != keypool_tail) {
+    __dmb(); // Entry is read after it was published
+    struct keypool_entry *entry = &keypool[keypool_tail & (KEYPOOL_SIZE - 1)];
+    memcpy(your_sk, entry->sk, KEYSZ);
+    memcpy(your_pk, entry->pk, KEYSZ);
+    memcpy(hidden, entry->hidden, KEYSZ);
+    crypto_wipe(entry, sizeof(struct keypool_entry));
+    __dmb(); // Entry is wiped before core1 can reuse it
+    keypool_tail++;
+    __sev(); // Wake up core1(core1.c)
+    TRACE_END(TRACE_KEY_POOL, trace_begin, keypool_head - keypool_tail);
+    return;
+ }
+#endif
+ key_hidden(your_sk, your_pk, hidden, KEYSZ); // Pool is empty
+}
+
+/*
+Prints the counters of XDRBG of the pool since boot(core1 updates them).
+*/
+void keypool_stats(void)
+{
+#if KEYPOOL_SIZE > 0
+ random_pool_stats(&keypool_drbg, "key_pool");
+#endif
+}
+/////////////////////////
+/////////////////////////
@@ -116,6 +116,7 @@
                             /* INCLUDE FILES                                  */
                             /* =============                                  */
 #include "include/lzrw.h"
+#include "include/lzrw3a16.h" //#NK 16-bit offset variant
 #include "memory.h"
 #define ULONG uint32_t
 
@@ -152,8 +153,8 @@ struct compress_identity identity =
 
 uint32_t lzrw3a_req_mem() { return MEM_REQ; };
 
-void lzrw3a_compress_compress  (UBYTE *,UBYTE *,ULONG,UBYTE *,ULONG *);
-void lzrw3a_compress_decompress(UBYTE *,UBYTE *,ULONG,UBYTE *,ULONG *);
+void lzrw3a_compress_compress  (UBYTE *,UBYTE *,ULONG,UBYTE *,ULONG *,int);
+void lzrw3a_compress_decompress(UBYTE *,UBYTE *,ULONG,UBYTE *,ULONG,ULONG *,int);
 
 /******************************************************************************/
 
@@ -169,10 +170,11 @@ EXPORT void lzrw3a_compress
  switch (action)
    {
     case COMPRESS_ACTION_COMPRESS:
-       lzrw3a_compress_compress(wrk_mem,src_adr,src_len,dst_adr,p_dst_len);
+       lzrw3a_compress_compress(wrk_mem,src_adr,src_len,dst_adr,p_dst_len,FALSE);
        break;
     case COMPRESS_ACTION_DECOMPRESS:
-       lzrw3a_compress_decompress(wrk_mem,src_adr,src_len,dst_adr,p_dst_len);
+       /* #NK Output zone of the original interface: at most nine times.   */
+       lzrw3a_compress_decompress(wrk_mem,src_adr,src_len,dst_adr,9*src_len,p_dst_len,FALSE);
        break;
    }
 }
@@ -337,7 +339,9 @@ void fast_copy(void *src, void *dest, unsigned long len) {
 /* and destination blocks are relatively longword aligned.                    */
 /* The actual flag data appears in the first byte. The rest are zeroed so as  */
 /* to normalize the compressed representation (i.e. not non-deterministic).   */
-#define FLAG_BYTES 4
+//#NK one byte, the flag is the header of compressed messages in chat 
+//    (COMPRESS_PACKED/COMPRESS_STORED in compress_decompress.h)
+#define FLAG_BYTES 1
 
 /* The following #defines define the meaning of the values of the copy        */
 /* flag at the start of the compressed file.                                  */
@@ -453,7 +457,7 @@ void fast_copy(void *src, void *dest, unsigned long len) {
 /******************************************************************************/
 
 LOCAL void lzrw3a_compress_compress
-	(UBYTE *p_wrk_mem,UBYTE *p_src_first,ULONG src_len,UBYTE *p_dst_first,ULONG* p_dst_len)
+	(UBYTE *p_wrk_mem,UBYTE *p_src_first,ULONG src_len,UBYTE *p_dst_first,ULONG* p_dst_len,int stream)
 /* Input  : Hand over the required amount of working memory in p_wrk_mem.     */
 /* Input  : Specify input block using p_src_first and src_len.                */
 /* Input  : Point p_dst_first to the start of the output zone (OZ).           */
@@ -523,6 +527,8 @@ LOCAL void lzrw3a_compress_compress
  /* These variables should really be declared "register", but I am worried    */
  /* about the possibility that extra register declarations will tempt stupid  */
  /* compilers to allocate all registers before they get to the innermostloop. */
+ //#NK in stream mode the table is kept from the previous block
+ if (!stream)
  {UCARD i; UBYTE **p_h=hash;
   #define ZH *p_h++=START_STRING_18
   for (i=0;i<256;i++)     /* 256=HASH_TABLE_LENGTH/16. */
@@ -549,7 +555,9 @@ LOCAL void lzrw3a_compress_compress
      register UCARD bestpos;    /* Holds number of best pointer seen so far.  */
 
     /* Test for overrun and jump to overrun code if necessary.                */
-    if (p_dst>p_dst_post)
+    //#NK in stream mode the block is never copied over, the decompressor 
+    //    would not update its table
+    if (p_dst>p_dst_post && !stream)
        goto overrun;
 
     /* The following cascade of if statements efficiently catches and deals   */
@@ -566,6 +574,10 @@ LOCAL void lzrw3a_compress_compress
              break;
           else
              {p_h0=&hash[ANY_HASH_INDEX]; /* Avoid undefined pointer. */
+              //#NK real partition of the literal, as the decompressor 
+              //    computes it, so the table stays in step for streaming
+              p_ziv=p_src;
+              if (p_src+2<p_src_post) p_h0=&hash[HASH(p_src)];
               goto literal;}
          }
       }
@@ -719,7 +731,7 @@ LOCAL void lzrw3a_compress_compress
 /******************************************************************************/
 
 LOCAL void lzrw3a_compress_decompress
-	(UBYTE *p_wrk_mem,UBYTE *p_src_first,ULONG src_len,UBYTE *p_dst_first,ULONG* p_dst_len)
+	(UBYTE *p_wrk_mem,UBYTE *p_src_first,ULONG src_len,UBYTE *p_dst_first,ULONG dst_max,ULONG* p_dst_len,int stream)
 /* Input  : Hand over the required amount of working memory in p_wrk_mem.     */
 /* Input  : Specify input block using p_src_first and src_len.                */
 /* Input  : Point p_dst_first to the start of the output zone.                */
@@ -730,6 +742,9 @@ LOCAL void lzrw3a_compress_decompress
 /* Output : Length of output block written to *p_dst_len.                     */
 /* Output : Output block in Mem[p_dst_first..p_dst_first+*p_dst_len-1].       */
 /* Output : Writes only  in Mem[p_dst_first..p_dst_first+*p_dst_len-1].       */
+/* #NK Input : dst_max is the size of the output zone. If the output would    */
+/* #NK         not fit or an item runs past the input, *p_dst_len is set to   */
+/* #NK         0xFFFFFFFF and the output is not complete.                     */
 {
  /* Byte pointers p_src and p_dst scan through the input and output blocks.   */
  register UBYTE *p_src = p_src_first+FLAG_BYTES;
@@ -774,6 +789,7 @@ LOCAL void lzrw3a_compress_decompress
  /* and return.                                                               */
  if (*p_src_first==FLAG_COPY)
    {
+    if (src_len-FLAG_BYTES>dst_max) goto bad;
     fast_copy(p_src_first+FLAG_BYTES,p_dst_first,src_len-FLAG_BYTES);
     *p_dst_len=src_len-FLAG_BYTES;
     return;
@@ -783,6 +799,8 @@ LOCAL void lzrw3a_compress_decompress
  /* Use of an unrolled loop speeds this up considerably.                      */
  /* The comment about register declarations above similar code in the         */
  /* compressor applies here too.                                              */
+ //#NK in stream mode the table is kept from the previous block
+ if (!stream)
  {UCARD i; UBYTE **p_h=hash;
   #define ZJ *p_h++=START_STRING_18
   for (i=0;i<256;i++)     /* 256=HASH_TABLE_LENGTH/16. */
@@ -794,7 +812,8 @@ LOCAL void lzrw3a_compress_decompress
 
  /* The outer loop processes either 1 or 16 items per iteration depending on  */
  /* how close p_src is to the end of the input block.                         */
- while (p_src!=p_src_post)
+ //#NK < instead of !=, a broken block must not run past the input
+ while (p_src<p_src_post)
    {/* Start of outer loop */
 
     register UCARD unroll;   /* Counts unrolled loop executions.              */
@@ -806,6 +825,8 @@ LOCAL void lzrw3a_compress_decompress
     /* of a group, we have to load a new control word and inject a new 1 bit. */
     if (control==1)
       {
+       //#NK a control word is always followed by an item
+       if (p_src_post-p_src<3) goto bad;
        control=0x10000|*p_src++;
        control|=(*p_src++)<<8;
       }
@@ -830,10 +851,13 @@ LOCAL void lzrw3a_compress_decompress
           register UCARD index;        /* Index of hash table copy pointer.   */
 
           /* Read and dismantle the copy word. Work out from where to copy.   */
+          if (p_src_post-p_src<2) goto bad;
           lenmt=*p_src++;
           index=((lenmt&0xF0)<<4)|*p_src++;
           p=hash[index];
           lenmt&=0xF;
+          //#NK the copy must fit the output zone
+          if (lenmt+3>dst_max-(ULONG)(p_dst-p_dst_first)) goto bad;
 
           /* Now perform the copy using a half unrolled loop. */
           *p_dst++=*p++;
@@ -865,6 +889,7 @@ LOCAL void lzrw3a_compress_decompress
           /* Literal item. */
 
           /* Copy over the literal byte. */
+          if ((ULONG)(p_dst-p_dst_first)==dst_max) goto bad;
           *p_dst++=*p_src++;
 
           /* If we now have three literals waiting to be hashed into the hash */
@@ -883,6 +908,314 @@ LOCAL void lzrw3a_compress_decompress
 
  /* Write the length of the decompressed data before returning. */
  *p_dst_len=p_dst-p_dst_first;
+ return;
+
+ /* #NK Jump here if the block does not fit dst_max or is broken.             */
+ bad:
+ *p_dst_len=U(0xFFFFFFFF);
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*     #NK STREAM MODE                                                        */
+/*     The hash table is kept between blocks, so a block can match the        */
+/*     history (earlier blocks) that precedes it in the same buffer. The      */
+/*     compressor and the decompressor must see the same blocks at the same   */
+/*     offsets of their history buffers and reset/rebase their tables at the  */
+/*     same points. Blocks are never copied over (FLAG_COPY), they expand by  */
+/*     at most FLAG_BYTES+2 bytes per 16 bytes of input.                      */
+/*                                                                            */
+/******************************************************************************/
+
+EXPORT void lzrw3a_stream_reset(UBYTE *wrk_mem)
+/* Points all elements of the hash table to the constant string.              */
+{
+ UBYTE **hash = (UBYTE **) ULONG_ALIGN_UP(wrk_mem);
+ UCARD i;
+ for (i=0;i<HASH_TABLE_LENGTH;i++) hash[i]=START_STRING_18;
+}
+
+EXPORT void lzrw3a_stream_compress
+	(UBYTE *wrk_mem,UBYTE *src_adr,ULONG src_len,UBYTE *dst_adr,ULONG* p_dst_len)
+/* Compresses the block that follows the history in the same buffer.          */
+/* Output zone: src_len+FLAG_BYTES+2*(src_len/16+1) bytes.                    */
+{
+ lzrw3a_compress_compress(wrk_mem,src_adr,src_len,dst_adr,p_dst_len,TRUE);
+}
+
+EXPORT void lzrw3a_stream_decompress
+	(UBYTE *wrk_mem,UBYTE *src_adr,ULONG src_len,UBYTE *dst_adr,ULONG dst_max,ULONG* p_dst_len)
+/* Decompresses the block right after the history in the same buffer, at     */
+/* most dst_max bytes (else *p_dst_len is 0xFFFFFFFF).                        */
+{
+ lzrw3a_compress_decompress(wrk_mem,src_adr,src_len,dst_adr,dst_max,p_dst_len,TRUE);
+}
+
+EXPORT void lzrw3a_stream_rebase
+	(UBYTE *wrk_mem,UBYTE *p_first,ULONG used,ULONG delta)
+/* The history Mem[p_first+delta..p_first+used-1] was moved to p_first:       */
+/* pointers into it are moved too, pointers to the dropped part are reset.    */
+{
+ UBYTE **hash = (UBYTE **) ULONG_ALIGN_UP(wrk_mem);
+ UBYTE *p_keep = p_first+delta;
+ UBYTE *p_post = p_first+used;
+ UCARD i;
+ for (i=0;i<HASH_TABLE_LENGTH;i++)
+   {
+    UBYTE *p=hash[i];
+    if (p>=p_first && p<p_post)
+       hash[i] = (p<p_keep) ? START_STRING_18 : p-delta;
+   }
+}
+
+EXPORT void lzrw3a_stream_prime(UBYTE *wrk_mem,UBYTE *p_dict,ULONG dict_len)
+/* #NK Puts positions of a dictionary (const data, stays in flash) to the     */
+/* hash table, the next blocks can match it. Both sides must prime the same   */
+/* dictionary at the same points. It must be followed by MAX_RAW_ITEM bytes   */
+/* that never occur in the text (zeros), so no match runs past its end.       */
+{
+ UBYTE **hash = (UBYTE **) ULONG_ALIGN_UP(wrk_mem);
+ UBYTE *p;
+ UCARD cycle=0;
+ for (p=p_dict;p+2<p_dict+dict_len;p++)
+    UPDATE_I(HASH(p),p);
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*     #NK LZRW3-A16                                                          */
+/*     The stream mode above with a hash table of 16-bit offsets from the     */
+/*     start of the history (p_base) instead of pointers, LZRW16_NIL stands   */
+/*     for START_STRING_18. The table has 2^bits entries (partitions of       */
+/*     HASH_TABLE_DEPTH), with bits=12 every decision and so the output is    */
+/*     the same as of lzrw3a_compress_compress/decompress.                    */
+/*                                                                            */
+/******************************************************************************/
+
+#define LZRW16_NIL 0xFFFF
+#define LZRW16_PTR(OFF) ((OFF)==LZRW16_NIL ? START_STRING_18 : p_base+(OFF))
+
+/* HASH of the original with 2^(bits-HASH_TABLE_DEPTH_BITS) partitions.      */
+#define LZRW16_HASH(PTR) \
+ ( \
+     (((40543*(((*(PTR))<<8)^((*((PTR)+1))<<4)^(*((PTR)+2))))>>4) & hash_mask) \
+  << HASH_TABLE_DEPTH_BITS \
+ )
+
+/* UPDATE_I of the original, the new pointer is stored as offset.            */
+#define LZRW16_UPDATE(I_BASE,NEWPTR) \
+{hash[(I_BASE)+cycle++]=(uint16_t)((NEWPTR)-p_base); cycle&=DEPTH_MASK;}
+
+EXPORT void lzrw3a16_init(uint8_t *wrk_mem, const int bits)
+/* Points all elements of the hash table to the constant string.              */
+{
+ uint16_t *hash = (uint16_t *) wrk_mem;
+ UCARD i;
+ for (i=0;i<(1u<<bits);i++) hash[i]=LZRW16_NIL;
+}
+
+EXPORT void lzrw3a16_compress
+	(uint8_t *wrk_mem,const int bits,uint8_t *src,uint32_t src_len,uint8_t *dst,uint32_t *dst_len,uint32_t history)
+/* Output zone: src_len+FLAG_BYTES+2*(src_len/16+1) bytes.                    */
+{
+ uint16_t *hash = (uint16_t *) wrk_mem;
+ UCARD hash_mask = (1u<<(bits-HASH_TABLE_DEPTH_BITS))-1;
+ UBYTE *p_base = src-history;
+ UBYTE *p_src = src;
+ UBYTE *p_src_post = src+src_len;
+ UBYTE *p_dst = dst;
+ UBYTE *p_control;
+ ULONG control=TOPWORD;
+ long h1=-1, h2=-1;  /* Partitions of the pending literals, -1 is empty.   */
+ UCARD cycle=0;
+
+ *p_dst++=FLAG_COMPRESS;
+ {UCARD i; for (i=2;i<=FLAG_BYTES;i++) *p_dst++=0;}
+ p_control=p_dst; p_dst+=2;
+
+ while (TRUE)
+   {
+    UCARD unroll=16;
+    int endgame=FALSE;
+    /* p_src>p_src_max16 and p_src>p_src_max1 of the original.                */
+    if (p_src_post-p_src<MAX_RAW_ITEM*16)
+      {
+       unroll=1;
+       if (p_src_post-p_src<MAX_RAW_ITEM)
+         {
+          if (p_src==p_src_post)
+             break;
+          endgame=TRUE;
+         }
+      }
+
+    while (unroll--)
+      {
+       UBYTE *p_ziv=p_src;
+       UCARD index=ANY_HASH_INDEX;
+       UCARD bestlen=0;
+       UCARD bestpos=0;
+       UCARD d;
+
+       if (endgame)
+         {
+          /* Literal without a search, partition as in the decompressor.      */
+          if (p_src+2<p_src_post) index=LZRW16_HASH(p_src);
+         }
+       else
+         {
+          index=LZRW16_HASH(p_src);
+          for (d=0;d<HASH_TABLE_DEPTH;d++)
+            {
+             UBYTE *p=LZRW16_PTR(hash[index+d]);
+             UCARD len=0;
+             if (bestlen<MAX_RAW_ITEM && p[bestlen]!=p_src[bestlen])
+                continue;
+             while (len<MAX_RAW_ITEM && p[len]==p_src[len]) len++;
+             if (len>bestlen)
+               {
+                bestpos=d;
+                bestlen=len;
+               }
+            }
+         }
+
+       if (bestlen<3)
+         {
+          /* Literal, the third pending literal updates the hash table.       */
+          *p_dst++=*p_src++; control&=0xFFFEFFFF;
+          if (h2>=0)
+             LZRW16_UPDATE(h2,p_ziv-2);
+          h2=h1; h1=index;
+         }
+       else
+         {
+          /* Copy item of the winning pointer, pending literals are updated. */
+          UCARD winner=index+bestpos;
+          *p_dst++=((winner&0xF00)>>4)|(bestlen-3);
+          *p_dst++=winner&0xFF;
+          p_src+=bestlen;
+          if (h1>=0)
+            {
+             if (h2>=0)
+               {LZRW16_UPDATE(h2,p_ziv-2); h2=-1;}
+             LZRW16_UPDATE(h1,p_ziv-1); h1=-1;
+            }
+          LZRW16_UPDATE(index,p_ziv);
+         }
+       control>>=1;
+      }
+
+    if ((control&TOPWORD)==0)
+      {
+       *p_control++=  control     &0xFF;
+       *p_control  = (control>>8) &0xFF;
+       p_control=p_dst; p_dst+=2;
+       control=TOPWORD;
+      }
+   }
+
+ while(control&TOPWORD) control>>=1;
+ *p_control++= control     &0xFF;
+ *p_control++=(control>>8) &0xFF;
+ if (p_control==p_dst) p_dst-=2;
+ *dst_len=p_dst-dst;
+}
+
+EXPORT void lzrw3a16_decompress
+	(uint8_t *wrk_mem,const int bits,uint8_t *src,uint32_t src_len,uint8_t *dst,uint32_t dst_max,uint32_t *dst_len,uint32_t history)
+/* Decompresses the block right after the history in the same buffer, at     */
+/* most dst_max bytes (else *dst_len is 0xFFFFFFFF).                          */
+{
+ uint16_t *hash = (uint16_t *) wrk_mem;
+ UCARD hash_mask = (1u<<(bits-HASH_TABLE_DEPTH_BITS))-1;
+ UCARD index_mask = (1u<<bits)-1;
+ UBYTE *p_base = dst-history;
+ UBYTE *p_src = src+FLAG_BYTES;
+ UBYTE *p_src_post = src+src_len;
+ UBYTE *p_dst = dst;
+ ULONG control=1;
+ UCARD literals=0;
+ UCARD cycle=0;
+
+ if (*src==FLAG_COPY)
+   {
+    if (src_len-FLAG_BYTES>dst_max) goto bad;
+    fast_copy(src+FLAG_BYTES,dst,src_len-FLAG_BYTES);
+    *dst_len=src_len-FLAG_BYTES;
+    return;
+   }
+
+ while (p_src<p_src_post)
+   {
+    UCARD unroll;
+    if (control==1)
+      {
+       if (p_src_post-p_src<3) goto bad;
+       control=0x10000|*p_src++;
+       control|=(*p_src++)<<8;
+      }
+    /* p_src<=p_src_max16 of the original.                                    */
+    unroll= p_src_post-p_src>=MAX_CMP_GROUP-2 ? 16 : 1;
+
+    while (unroll--)
+      {
+       if (control&1)
+         {
+          UBYTE *p_ziv=p_dst;
+          UCARD lenmt, index;
+          UBYTE *p;
+          if (p_src_post-p_src<2) goto bad;
+          lenmt=*p_src++;
+          /* Masked, so a foreign index can not leave a smaller table.       */
+          index=(((lenmt&0xF0)<<4)|*p_src++)&index_mask;
+          p=LZRW16_PTR(hash[index]);
+          lenmt&=0xF;
+          if (lenmt+3>dst_max-(ULONG)(p_dst-dst)) goto bad;
+          *p_dst++=*p++;
+          *p_dst++=*p++;
+          *p_dst++=*p++;
+          while (lenmt--)
+             *p_dst++=*p++;
+          if (literals>0)
+            {
+             UBYTE *r=p_ziv-literals;
+             LZRW16_UPDATE(LZRW16_HASH(r),r);
+             if (literals==2)
+                {r++; LZRW16_UPDATE(LZRW16_HASH(r),r);}
+             literals=0;
+            }
+          LZRW16_UPDATE(index&(~DEPTH_MASK),p_ziv);
+         }
+       else
+         {
+          if ((ULONG)(p_dst-dst)==dst_max) goto bad;
+          *p_dst++=*p_src++;
+          if (++literals == 3)
+             {UBYTE *p=p_dst-3;
+              LZRW16_UPDATE(LZRW16_HASH(p),p); literals=2;}
+         }
+       control>>=1;
+      }
+   }
+ *dst_len=p_dst-dst;
+ return;
+
+ bad:
+ *dst_len=0xFFFFFFFF;
+}
+
+EXPORT void lzrw3a16_rebase(uint8_t *wrk_mem, const int bits, const uint32_t delta)
+/* The history dropped its first delta bytes: offsets move by delta, offsets  */
+/* into the dropped part point to the constant string.                        */
+{
+ uint16_t *hash = (uint16_t *) wrk_mem;
+ UCARD i;
+ for (i=0;i<(1u<<bits);i++)
+   {
+    if (hash[i]!=LZRW16_NIL)
+       hash[i] = (hash[i]<delta) ? LZRW16_NIL : hash[i]-delta;
+   }
 }
 
 /******************************************************************************/
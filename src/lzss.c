@@ -0,0 +1,184 @@
+// Client-server API(PICO)        //
+// LZSS compression               //
+// Version 0.9.1pi                //
+// Bachelor's Work Project        //
+// Technical University of Kosice //
+// 17.10.2026                     //
+// Nikita Kuropatkin              //
+// Version for MCU                //
+// W5100S-EVB-Pico                //
+
+#include <stdint.h>
+#include <string.h>
+#include "include/lzss.h"
+#include "include/compress_decompress.h" //COMPRESS_PACKED
+
+/*
+Empty element of hash chains. Positions are relative to the start of
+the history(src - history), so they fit 16 bits.
+*/
+#define LZSS_NIL 0xFFFF
+#define LZSS_HASH_SIZE (1 << LZSS_HASH_BITS)
+#define LZSS_MASK (LZSS_WINDOW - 1)
+
+/*
+Hash of 3 bytes at `p` to the index of the head of its chain.
+*/
+static uint32_t lzss_hash(const uint8_t *p)
+{
+ uint32_t x = (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16);
+ return (x * 2654435761u) >> (32 - LZSS_HASH_BITS);
+}
+
+/*
+Adds position `pos`(relative to the start of the history) to its chain.
+*/
+static void lzss_insert(uint16_t *head, uint16_t *prev, const uint8_t *base, const uint32_t pos)
+{
+ uint32_t h = lzss_hash(base + pos);
+ prev[pos & LZSS_MASK] = head[h];
+ head[h] = (uint16_t)pos;
+}
+
+/*
+The function prepares the work memory `wrk_mem`(LZSS_MEM bytes) for
+a block without history.
+*/
+void lzss_init(uint8_t *wrk_mem)
+{
+ /*All bytes 0xFF, every element is LZSS_NIL*/
+ memset(wrk_mem, 0xFF, LZSS_MEM);
+}
+
+/*
+The function compresses `src_len` bytes of `src` to `dst`.
+Every position of the block goes to the chains, also the ones inside
+of matches, so the next messages can match any part of it.
+*/
+void lzss_compress(uint8_t *wrk_mem, uint8_t *src, uint32_t src_len, uint8_t *dst, uint32_t *dst_len, uint32_t history)
+{
+ uint16_t *head = (uint16_t *)wrk_mem;
+ uint16_t *prev = head + LZSS_HASH_SIZE;
+ const uint8_t *base = src - history;
+ const uint32_t end = history + src_len;
+ uint32_t pos = history;
+ uint8_t *p_dst = dst;
+ uint8_t *p_control;
+ uint8_t bit = 0;
+
+ *p_dst++ = COMPRESS_PACKED;
+ p_control = p_dst++;
+ *p_control = 0;
+ while (pos < end) {
+    uint32_t best_len = 0;
+    uint32_t best_off = 0;
+    /*Matches need 3 bytes for the hash*/
+    if (pos + LZSS_MIN_MATCH <= end) {
+       uint32_t max_len = end - pos;
+       if (max_len > LZSS_MAX_MATCH) max_len = LZSS_MAX_MATCH;
+       uint32_t cand = head[lzss_hash(base + pos)];
+       for (int depth = 0; depth < LZSS_DEPTH && cand != LZSS_NIL; depth++) {
+          /*Older than the window or stale(slot reused by a newer position)*/
+          if (cand >= pos || pos - cand > LZSS_WINDOW) break;
+          const uint8_t *p = base + cand;
+          const uint8_t *s = base + pos;
+          if (p[best_len] == s[best_len]) {
+             uint32_t len = 0;
+             while (len < max_len && p[len] == s[len]) len++;
+             if (len > best_len) {
+                best_len = len;
+                best_off = pos - cand;
+                if (len == max_len) break;
+             }
+          }
+          uint32_t next = prev[cand & LZSS_MASK];
+          if (next != LZSS_NIL && next >= cand) break;
+          cand = next;
+       }
+    }
+
+    if (best_len >= LZSS_MIN_MATCH) {
+       uint32_t word = ((best_off - 1) << LZSS_LEN_BITS) | (best_len - LZSS_MIN_MATCH);
+       *p_control |= (uint8_t)(1 << bit);
+       *p_dst++ = (uint8_t)(word >> 8);
+       *p_dst++ = (uint8_t)word;
+    } else {
+       best_len = 1;
+       *p_dst++ = base[pos];
+    }
+    for (uint32_t i = 0; i < best_len; i++, pos++) {
+       if (pos + LZSS_MIN_MATCH <= end) {
+          lzss_insert(head, prev, base, pos);
+       }
+    }
+
+    if (++bit == 8 && pos < end) {
+       bit = 0;
+       p_control = p_dst++;
+       *p_control = 0;
+    }
+ }
+ /*Empty block has no items, the control byte is dropped*/
+ if (src_len == 0) p_dst--;
+ *dst_len = (uint32_t)(p_dst - dst);
+}
+
+/*
+The function decompresses `src_len` bytes of `src` to at most `dst_max`
+bytes of `dst`, the work memory is not used.
+*/
+void lzss_decompress(uint8_t *wrk_mem, uint8_t *src, uint32_t src_len, uint8_t *dst, uint32_t dst_max, uint32_t *dst_len, uint32_t history)
+{
+ (void)wrk_mem;
+ const uint8_t *p_src = src + 1; // Header
+ const uint8_t *p_end = src + src_len;
+ uint8_t *p_dst = dst;
+
+ while (p_src < p_end) {
+    uint8_t control = *p_src++;
+    for (int bit = 0; bit < 8 && p_src < p_end; bit++) {
+       if (control & (1 << bit)) {
+          if (p_end - p_src < 2) {
+             *dst_len = UINT32_MAX;
+             return;
+          }
+          uint32_t word = ((uint32_t)p_src[0] << 8) | p_src[1];
+          uint32_t off = (word >> LZSS_LEN_BITS) + 1;
+          uint32_t len = (word & ((1 << LZSS_LEN_BITS) - 1)) + LZSS_MIN_MATCH;
+          p_src += 2;
+          if (off > (uint32_t)(p_dst - dst) + history || len > dst_max - (uint32_t)(p_dst - dst)) {
+             *dst_len = UINT32_MAX;
+             return;
+          }
+          /*Byte by byte, the match can overlap its own output*/
+          const uint8_t *p = p_dst - off;
+          while (len--) *p_dst++ = *p++;
+       } else {
+          if ((uint32_t)(p_dst - dst) == dst_max) {
+             *dst_len = UINT32_MAX;
+             return;
+          }
+          *p_dst++ = *p_src++;
+       }
+    }
+ }
+ *dst_len = (uint32_t)(p_dst - dst);
+}
+
+/*
+The history of `used` bytes at `first` has dropped its first `delta`
+bytes(moved to `first`). Slots of the previous positions depend on
+the positions, so the chains are built again from the last
+LZSS_WINDOW bytes of what is left.
+*/
+void lzss_rebase(uint8_t *wrk_mem, uint8_t *first, uint32_t used, uint32_t delta)
+{
+ uint16_t *head = (uint16_t *)wrk_mem;
+ uint16_t *prev = head + LZSS_HASH_SIZE;
+ uint32_t kept = used - delta;
+ uint32_t pos = kept > LZSS_WINDOW ? kept - LZSS_WINDOW : 0;
+ lzss_init(wrk_mem);
+ for (; pos + LZSS_MIN_MATCH <= kept; pos++) {
+    lzss_insert(head, prev, first, pos);
+ }
+}
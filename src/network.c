@@ -14,6 +14,9 @@
 #include "include/network.h"
 #include "include/parameters.h"
 #include "include/error.h" //All errors defined + function proto
+#include "include/trace.h"
+#include "include/timing.h" //millis()
+#include "pico/stdlib.h" //sleep_us()
 
 /*Network libraries(will be used by client)*/
 #include "socket.h"
@@ -28,14 +31,46 @@ It takes the following parameters:
 1. `sockfd` - the ID of the socket where the data will be received.  
 2. `msg` - a buffer where the received message will be written.  
 3. `size` - the size of the message.  
-The program exits in case of an error.
+The function returns only when exactly `size` bytes were received 
+(a frame can be split into several TCP segments). The received size 
+register is polled every NET_POLL_US us, so the call is never blocked 
+inside recv() and after the first byte the rest must come in NET_TIMEOUT
+ms. Waiting for the first byte has no deadline on purpose: in turn-based
+chat it is the time the user on the other side types the reply. A closed
+connection still ends the wait.
+The program exits in case of an error, closed connection or timeout.
 */
 void read_pico(const int sockfd, uint8_t *msg, const unsigned int size)
 {
- int retval = recv(sockfd, msg, size);
- if (retval <= 0) {
-   exit_with_error(ERROR_RECEIVING_DATA, "Recieving failed");
+ TRACE_BEGIN(trace_begin);
+ unsigned int received = 0; // Bytes already in `msg`
+ uint32_t start_ms = (uint32_t)millis(); // Start of the deadline(first byte)
+
+ while (received < size) {
+    uint16_t avail = getSn_RX_RSR(sockfd); // Bytes waiting in RX memory
+    if (avail == 0) {
+       /*Other side closed connection and nothing is left to read*/
+       if (getSn_SR(sockfd) != SOCK_ESTABLISHED) {
+          exit_with_error(ERROR_RECEIVING_DATA, "Recieving failed");
+       }
+       /*Waiting for the first byte is not limited*/
+       if (received > 0 && ((uint32_t)millis() - start_ms) >= NET_TIMEOUT) {
+          exit_with_error(ERROR_RECEIVING_DATA, "Recieving timed out");
+       }
+       sleep_us(NET_POLL_US);
+       continue;
+    }
+    if (received == 0) start_ms = (uint32_t)millis();
+
+    /*Never ask for more than is missing(next frame stays in RX memory)*/
+    if (avail > size - received) avail = size - received;
+    int32_t retval = recv(sockfd, msg + received, avail);
+    if (retval <= 0) {
+       exit_with_error(ERROR_RECEIVING_DATA, "Recieving failed");
+    }
+    received += retval;
  }
+ TRACE_END(TRACE_READ, trace_begin, size);
 }
 //////////////////////////////////////////
 //////////////////////////////////////////
@@ -50,14 +85,31 @@ It takes the following parameters:
 1. `sockfd` - the ID of the socket from which the data will be sent.  
 2. `msg` - a buffer containing the message to be sent.  
 3. `size` - the size of the message.  
-The program exits in case of an error.
+send() moves at most the free size of the socket TX memory, 
+so the function repeats it(after NET_POLL_US us) until all `size` 
+bytes are sent or NET_TIMEOUT ms passed.
+The program exits in case of an error or timeout.
 */
 void write_pico(const int sockfd, uint8_t *msg, const unsigned int size)
 {
- int retval = send(sockfd, msg, size);
- if (retval != size) {
-   exit_with_error(ERROR_SENDING_DATA, "Writing failed");
+ TRACE_BEGIN(trace_begin);
+ unsigned int sent = 0; // Bytes already sent from `msg`
+ uint32_t start_ms = (uint32_t)millis(); // Start of the deadline
+
+ while (sent < size) {
+    int32_t retval = send(sockfd, msg + sent, size - sent);
+    if (retval < 0) {
+       exit_with_error(ERROR_SENDING_DATA, "Writing failed");
+    }
+    sent += retval; // SOCK_BUSY(0) means TX memory is full, try again
+    if (sent < size && ((uint32_t)millis() - start_ms) >= NET_TIMEOUT) {
+       exit_with_error(ERROR_SENDING_DATA, "Writing timed out");
+    }
+    if (retval == SOCK_BUSY) {
+       sleep_us(NET_POLL_US);
+    }
  } 
+ TRACE_END(TRACE_WRITE, trace_begin, size);
 }
 //////////////////////////////////////////
 //////////////////////////////////////////
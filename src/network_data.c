@@ -49,6 +49,13 @@ Do not change these values!
 */
 uint8_t g_ethernet_buf[ETHERNET_BUF_MAX_SIZE] = {0};
 
+/*
+YES while the DHCP client owns socket SOCKET_DHCP(between DHCP_init() 
+and DHCP_stop()), so the socket is opened only once and the lease 
+can be renewed between sessions.
+*/
+static int dhcp_started = NO;
+
 /*
 A pointer to the memory address of the specified flash page,  
 offset from `XIP_BASE` (the base address for flash memory access).
@@ -248,6 +255,7 @@ void ip_check (char *ip)
  if (test<IPSTART || test>IPEND) exit_with_error(ERROR_IP_INPUT,"Invalid IP"); 
  while (ptr != NULL) {
     ptr = strtok(NULL, ".");
+    if (ptr == NULL) break; // Stop if there are no more tokens
     test = atoi(ptr); //Convert one octet of ipv4 to a decimal form
     /*Checking other octets of IP*/
     if (test<IPSTART || test>IPEND) exit_with_error(ERROR_IP_INPUT,"Invalid IP"); 
@@ -292,6 +300,7 @@ static void mac_check(char *mac) {
 
   while (ptr != NULL) {
     ptr = strtok(NULL, ":");
+    if (ptr == NULL) break; // Stop if there are no more tokens
     test = (int)strtol(ptr, NULL, 16);
     
     // Validate remaining MAC segments
@@ -409,6 +418,7 @@ static void dhcp_usage(void) {
       // Stop DHCP process after exceeding retry limit
       if (dhcp_retry > DHCP_RETRY_COUNT) {
         DHCP_stop();
+        dhcp_started = NO;
         exit_with_error(DHCP_ERROR, "DHCP failed");
       }
 
@@ -458,7 +468,12 @@ static void wizchip_dhcp_conflict(void) {
 Initializes the DHCP client and registers necessary callback functions.
 */
 static void wizchip_dhcp_init(void) {
+  // Socket of the previous DHCP client is closed before reuse
+  if (dhcp_started == YES) {
+    DHCP_stop();
+  }
   DHCP_init(SOCKET_DHCP, g_ethernet_buf);
+  dhcp_started = YES;
 
   // Register callback functions for DHCP events
   reg_dhcp_cbfunc(wizchip_dhcp_assign, wizchip_dhcp_assign, wizchip_dhcp_conflict);
@@ -466,6 +481,50 @@ static void wizchip_dhcp_init(void) {
 ///////////////////////////
 ///////////////////////////
 
+//////////////////////////
+/// DHCP Lease Renewal ///
+//////////////////////////
+/*
+Keeps the DHCP lease valid between sessions. Does nothing with static
+settings. The DHCP client keeps its socket open, DHCP_run() renews the
+lease when half of the lease time(counted by DHCP_time_handler()) passed.
+If the lease was lost, DHCP is started again.
+
+Takes as input parameter:
+  - net_info: The pointer to the network info of the session, updated
+    if the server assigned other settings.
+
+Returns YES if the settings changed(chip must be configured again), 
+otherwise NO.
+*/
+int dhcp_maintain(wiz_NetInfo *net_info) {
+  if (your_net_info.dhcp != NETINFO_DHCP) {
+    return NO;
+  }
+
+  uint8_t retval = DHCP_IP_LEASED;
+  if (dhcp_started == YES) {
+    do {
+      retval = DHCP_run(); // Running only during renewal request
+    } while (retval == DHCP_RUNNING);
+  }
+
+  if (dhcp_started == NO || retval == DHCP_FAILED || retval == DHCP_STOPPED) {
+    printf("Renewing DHCP lease...\n");
+    wizchip_dhcp_init();
+    dhcp_usage();
+    retval = DHCP_IP_CHANGED;
+  }
+
+  if (retval == DHCP_IP_LEASED) {
+    return NO;
+  }
+  *net_info = your_net_info;
+  return YES;
+}
+///////////////////////////
+///////////////////////////
+
 ///////////////////////////////
 ///// Network Configuration ///
 ///////////////////////////////
@@ -477,6 +536,15 @@ Takes as input parameter:
   - netinfo_type: The network configuration type (Last used, DHCP, or Manual).
 */
 static void configure_network(const NetInfoType netinfo_type) {
+  // Static settings replace DHCP, its socket is released
+  if (netinfo_type != NETDATA_DHCP && dhcp_started == YES) {
+    DHCP_stop();
+    dhcp_started = NO;
+  }
+  if (netinfo_type != NETDATA_DHCP) {
+    your_net_info.dhcp = NETINFO_STATIC;
+  }
+
   switch (netinfo_type) {
     case NETDATA_LAST:
       printf("Configuring with last used network settings...\n");
@@ -537,7 +605,7 @@ Takes as input parameter:
   - param: The offset address of the flash sector to be erased.
 */
 static void call_flash_range_erase(void *param) {
-  uint32_t offset = (uint32_t)param; // Get the offset from parameters
+  uint32_t offset = (uint32_t)(uintptr_t)param; // Get the offset from parameters
   flash_range_erase(offset, FLASH_SECTOR_SIZE); // Erase flash sector
 }
 ////////////////////////////////
@@ -9,38 +9,166 @@
 // W5100S-EVB-Pico                //
 
 #include <stdint.h>
+#include <stdio.h>
+#include <string.h>
 #include "include/error.h" // All errors are defined + function prototypes
 #include "include/random.h"
 #include "random_entropy.h"
 #include "include/xdrbg.h"
 #include "include/parameters.h"
 #include "include/monocypher.h"
+#include "include/trace.h"
 
 //////////////////////////////////////////
 /// Random Numbers Generator        ///
 //////////////////////////////////////////
 
 /*
-Working state for xdrbg random bit generator
+Working state for xdrbg random bit generator with its pool of bytes
 Do not change this value!
 */
-static struct lc_xdrbg256_drng_state xdrbg256_ctx = { 0 };
+static struct random_pool xdrbg256_pool = { 0 };
+
+/*
+Function: xdrbg_permutations
+Purpose: Returns the number of Keccak-f[1600] permutations done by one 
+lc_xdrbg256_drng_generate() call. Every chunk(up to 2 rate blocks) 
+squeezes the new V(64 bytes) and then the output from the same blocks.
+Input:
+    - size: The number of generated bytes.
+*/
+static uint32_t xdrbg_permutations(size_t size) {
+ uint32_t permutations = 0;
+ while (size > 0) {
+    size_t todo = (size > RANDOM_CHUNK) ? RANDOM_CHUNK : size;
+    permutations += (uint32_t)((LC_XDRBG256_DRNG_KEYSIZE + todo + RANDOM_RATE - 1) / RANDOM_RATE);
+    size -= todo;
+ }
+ return permutations;
+}
+
+/*
+Function: random_pool_seed
+Purpose: Seeds XDRBG of the pool, bytes left in the pool are wiped.
+Input:
+    - pool: Pointer to the pool.
+    - seed: Pointer to the entropy data used for seeding.
+    - size: Length of the seed data in bytes.
+Output:
+    - Returns OK on success, or a non-zero value on failure.
+*/
+int random_pool_seed(struct random_pool *pool, uint8_t *seed, const size_t size) {
+ crypto_wipe(pool->bytes, RANDOM_POOL_SIZE);
+ pool->left = 0;
+ return lc_xdrbg256_drng_seed(&pool->drbg, seed, size);
+}
+
+/*
+Function: random_pool_generate
+Purpose: Fills `out` with random bytes of XDRBG. With RANDOM_POOL set to 
+YES, requests up to RANDOM_POOL_SIZE bytes are served from the pool, 
+which is refilled by one generate call(two SHAKE rate blocks, the same 
+number of permutations as a generate of 73 bytes). Served bytes are 
+wiped. Bigger requests are generated directly.
+Input:
+    - pool: Pointer to the pool.
+    - out: Pointer to the output buffer.
+    - size: The number of random bytes.
+Output:
+    - Returns OK on success, or a non-zero value on failure.
+*/
+int random_pool_generate(struct random_pool *pool, uint8_t *out, size_t size) {
+ pool->requests++;
+ pool->permutations_direct += xdrbg_permutations(size);
+
+ if (RANDOM_POOL != YES || size > RANDOM_POOL_SIZE) {
+    pool->permutations += xdrbg_permutations(size);
+    return lc_xdrbg256_drng_generate(&pool->drbg, out, size);
+ }
+
+ while (size > 0) {
+    if (pool->left == 0) {
+       int status = lc_xdrbg256_drng_generate(&pool->drbg, pool->bytes, RANDOM_POOL_SIZE);
+       if (status != OK) {
+          return status;
+       }
+       pool->permutations += xdrbg_permutations(RANDOM_POOL_SIZE);
+       pool->left = RANDOM_POOL_SIZE;
+    }
+    /*Bytes are served from the end, `left` bytes at the start are unused*/
+    size_t todo = (size > pool->left) ? pool->left : size;
+    uint8_t *from = &pool->bytes[pool->left - todo];
+    memcpy(out, from, todo);
+    crypto_wipe(from, todo);
+    pool->left -= (uint32_t)todo;
+    out += todo;
+    size -= todo;
+ }
+ return OK;
+}
+
+/*
+Function: random_pool_stats
+Purpose: Prints the counters of the pool as a comment line of the trace 
+CSV: requests, Keccak-f[1600] permutations done and permutations that 
+the requests would need without the pool.
+Input:
+    - pool: Pointer to the pool.
+    - name: Name of the pool in the output.
+*/
+void random_pool_stats(const struct random_pool *pool, const char *name) {
+ uint32_t saved = (pool->permutations_direct > pool->permutations) ?
+                  pool->permutations_direct - pool->permutations : 0;
+ printf("# %s: %lu requests, %lu permutations(%lu without pool, %lu saved)\n", name,
+        (unsigned long)pool->requests, (unsigned long)pool->permutations,
+        (unsigned long)pool->permutations_direct, (unsigned long)saved);
+}
+
+/*
+Function: random_pool_reset_stats
+Purpose: Sets the counters of the pool to zero.
+Input:
+    - pool: Pointer to the pool.
+*/
+void random_pool_reset_stats(struct random_pool *pool) {
+ pool->requests = 0;
+ pool->permutations = 0;
+ pool->permutations_direct = 0;
+}
 
 /*
 Function: random_num
 Purpose: Generates random bytes using XDRBG and fills the provided array 
-with them.
+with them. Small requests are served from the pool(RANDOM_POOL).
 Input:
     - number: Pointer to the array that will be filled with random bytes.
     - size: The number of random bytes to generate and store in the `number` 
       array.
 */
 void random_num(uint8_t *number,const int size) {
- if (lc_xdrbg256_drng_generate(&xdrbg256_ctx, number, size) != OK) {
+ if (random_pool_generate(&xdrbg256_pool, number, (size_t)size) != OK) {
    exit_with_error(ERROR_GENERATING_RANDOM, "Error generating random bits");
  }
 }
 
+/*
+Function: random_stats
+Purpose: Prints the counters of random_num() since the last 
+random_stats_reset()(one session).
+*/
+void random_stats(void) {
+ random_pool_stats(&xdrbg256_pool, "random_num");
+}
+
+/*
+Function: random_stats_reset
+Purpose: Sets the counters of random_num() to zero, called at the 
+beginning of every session.
+*/
+void random_stats_reset(void) {
+ random_pool_reset_stats(&xdrbg256_pool);
+}
+
 /*
 Function: random_init
 Purpose: Initializes the random number generator by seeding the 
@@ -48,16 +176,18 @@ XDRBG with entropy.
 This function generates entropy and seeds the XDRBG.
 */
 void random_init(void) {
+ TRACE_BEGIN(trace_begin);
  // Entropy that we will use for XDRBG seeding
  uint8_t entropy[SEED_SIZE];
  random_entropy(entropy, SEED_SIZE);
 
- if (lc_xdrbg256_drng_seed(&xdrbg256_ctx, entropy, sizeof(entropy)) != OK) 
+ if (random_pool_seed(&xdrbg256_pool, entropy, sizeof(entropy)) != OK) 
  {
    exit_with_error(ERROR_SEEDING_XDRBG, "Error seeding XDRBG");
  }
 
  crypto_wipe(entropy,SEED_SIZE); //Wiping entropy after seeding the XDRBG
+ TRACE_END(TRACE_RANDOM_INIT, trace_begin, SEED_SIZE);
 }
 
 /*
@@ -11,6 +11,8 @@
 #include "include/timing.h"
 #include "include/parameters.h"
 #include "port_common.h"
+#include "dhcp.h"
+#include "include/client/pin.h" //pin_cache_tick()
 
 /* 
 Initial value for a global millisecond counter.
@@ -47,9 +49,16 @@ void set_clock_khz(void) {
 
 /*
 Function that repeatedly increments the counter every millisecond.
+Every second it also ticks the DHCP client, its timeouts and
+the lease renewal are counted in seconds by DHCP_time_handler(),
+and the idle timeout of the unlocked key cache(pin_cache_tick()).
 */
 void repeating_timer_callback(void) {
  g_msec_cnt++;  
+ if (g_msec_cnt % 1000 == 0) {
+    DHCP_time_handler();
+    pin_cache_tick();
+ }
 }
 
 /*
@@ -0,0 +1,149 @@
+// Client-server API(PICO)        //
+// Phase tracing                  //
+// Version 0.9.1pi                //
+// Bachelor's Work Project        //
+// Technical University of Kosice //
+// 17.10.2026                     //
+// Nikita Kuropatkin              //
+// Version for MCU                //
+// W5100S-EVB-Pico                //
+
+#include <stdio.h>
+#include <string.h>
+#include "include/trace.h"
+#include "include/parameters.h" //Macros are defined here
+#include "pico/stdlib.h" //time_us_32()
+#include "hardware/sync.h" //Spin lock shared by the cores
+
+#if (TRACE_SIZE & (TRACE_SIZE - 1)) != 0
+  #error "TRACE_SIZE must be a power of two"
+#endif
+
+/*
+Names of the phases in CSV output, order of enum trace_phase.
+*/
+static const char *const trace_names[TRACE_PHASES] = {
+ "random_init",
+ "connect",
+ "key_hidden",
+ "key_pool",
+ "pin_checker",
+ "hashing_pin",
+ "pin_wait",
+ "kdf",
+ "read_pico",
+ "write_pico",
+ "compress_text",
+ "aead_write",
+ "aead_read",
+ "decompress_text"
+};
+
+/*
+Ring buffer of the traced phases(statically allocated in BSS)
+and the number of records written since the last reset.
+*/
+static struct trace_entry trace_ring[TRACE_SIZE];
+static uint32_t trace_count = 0;
+
+/*
+Hardware spin lock of the ring, both cores record phases(core1 hashes 
+the PIN). Claimed by the first record, which is made by core0 in 
+random_init() before core1 is launched.
+*/
+static spin_lock_t *trace_lock = NULL;
+
+/*
+Claims the spin lock on the first use and locks it.
+Returns the saved interrupt state for spin_unlock().
+*/
+static uint32_t trace_lock_blocking(void)
+{
+ if (trace_lock == NULL) {
+    trace_lock = spin_lock_instance((unsigned int)spin_lock_claim_unused(true));
+ }
+ return spin_lock_blocking(trace_lock);
+}
+
+/////////////////////////
+///   Trace recorder  ///
+/////////////////////////
+/*
+Returns the current value of the microsecond timer(time_us_32()).
+*/
+uint32_t trace_now(void)
+{
+ return time_us_32();
+}
+
+/*
+Stores one phase into the ring buffer, overwrites the oldest entry if
+the ring is full. Does not print anything.
+Parameters:
+- `phase`: Value from enum trace_phase.
+- `begin_us`: Timestamp taken by trace_now() at the start of the phase.
+- `arg`: Phase argument(size of data, count of iterations),
+  values bigger than 65535 are saturated.
+*/
+void trace_record(const uint8_t phase, const uint32_t begin_us, const uint32_t arg)
+{
+ uint32_t end_us = time_us_32();
+ uint32_t save = trace_lock_blocking();
+ struct trace_entry *entry = &trace_ring[trace_count & (TRACE_SIZE - 1)];
+ entry->end_us = end_us;
+ entry->begin_us = begin_us;
+ entry->arg = (arg > UINT16_MAX) ? UINT16_MAX : (uint16_t)arg;
+ entry->phase = phase;
+ trace_count++;
+ spin_unlock(trace_lock, save);
+}
+
+/*
+Clears the ring buffer, called at the beginning of every session.
+*/
+void trace_reset(void)
+{
+ uint32_t save = trace_lock_blocking();
+ memset(trace_ring, 0, sizeof(trace_ring));
+ trace_count = 0;
+ spin_unlock(trace_lock, save);
+}
+/////////////////////////
+/////////////////////////
+
+/////////////////////////
+///   Trace printing  ///
+/////////////////////////
+/*
+Prints the ring buffer as CSV(oldest entry first) to stdout:
+seq,phase,begin_us,end_us,duration_us,arg
+Times are relative to the first stored entry.
+*/
+void trace_dump(void)
+{
+ if (TRACE != YES) {
+    printf("Tracing is disabled(TRACE in parameters.h).\n");
+    return;
+ }
+
+ /*If the ring overflowed, the oldest entry is the next one to overwrite*/
+ uint32_t first = (trace_count > TRACE_SIZE) ? trace_count - TRACE_SIZE : 0;
+ uint32_t origin = trace_ring[first & (TRACE_SIZE - 1)].begin_us;
+
+ printf("seq,phase,begin_us,end_us,duration_us,arg\n");
+ for (uint32_t i = first; i < trace_count; i++) {
+    const struct trace_entry *entry = &trace_ring[i & (TRACE_SIZE - 1)];
+    const char *name = (entry->phase < TRACE_PHASES) ? trace_names[entry->phase] : "unknown";
+    /*Nested phases are stored at their end, so begin can precede origin*/
+    printf("%lu,%s,%ld,%ld,%lu,%u\n", (unsigned long)i, name,
+           (long)(int32_t)(entry->begin_us - origin),
+           (long)(int32_t)(entry->end_us - origin),
+           (unsigned long)(entry->end_us - entry->begin_us),
+           (unsigned)entry->arg);
+ }
+ if (first > 0) {
+    printf("# %lu oldest entries were overwritten(TRACE_SIZE %d)\n", (unsigned long)first, TRACE_SIZE);
+ }
+}
+/////////////////////////
+/////////////////////////
@@ -46,6 +46,8 @@
 /*   #Added wiping of the seed value from the stack after initialization      */  
 /*     in `lc_xdrbg256_drng_seed`. Also wiping `partial` at the end of        */  
 /*     `lc_xdrbg256_drng_generate` due to security concerns.                  */  
+/*   #`keccakp_1600` calls `keccakp_1600_64`(original code) or the 32-bit     */  
+/*     bit-interleaved `keccakp_1600_bi`(keccak_bi.c), see KECCAK_BACKEND.    */  
 /******************************************************************************/ 
 
   
@@ -75,6 +77,8 @@
 #include <sys/types.h>
 #include "include/xdrbg.h"
 #include "include/monocypher.h"
+#include "include/parameters.h" //KECCAK_BACKEND
+#include "include/keccak_bi.h"
 
 static inline size_t min_size(size_t a, size_t b)
 {
@@ -202,7 +206,12 @@ static inline void keccakp_chi_iota(uint64_t s[25], unsigned int round)
 	s[A(4, 4)] ^= ~t0[4] & t1[4];
 }
 
-static inline void keccakp_1600(uint64_t s[25])
+/*
+#NK
+Renamed from `keccakp_1600` and made public for the comparison with
+the 32-bit interleaved backend(keccak_bi.c) in bench_crypto.
+*/
+void keccakp_1600_64(uint64_t s[25])
 {
 	unsigned int round;
 
@@ -212,6 +221,20 @@ static inline void keccakp_1600(uint64_t s[25])
 	}
 }
 
+/*
+#NK
+Backend of the permutation is chosen by KECCAK_BACKEND(parameters.h).
+*/
+static inline void keccakp_1600(uint64_t s[25])
+{
+#if KECCAK_BACKEND == KECCAK_32BI || \
+    (KECCAK_BACKEND == KECCAK_AUTO && UINTPTR_MAX == 0xFFFFFFFFU)
+	keccakp_1600_bi(s);
+#else
+	keccakp_1600_64(s);
+#endif
+}
+
 /******************************** SHA / SHAKE *********************************/
 
 #define LC_SHA3_SIZE_BLOCK(bits) ((1600 - 2 * bits) >> 3)